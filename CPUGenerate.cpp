@@ -0,0 +1,33 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Build time generator of the CPU tables (CPUGroup.h and GTable.h) for
+// CPU_GRP_SIZE and GTABLE_WINDOW. Linked with SECP256K1.cpp compiled with
+// GTABLE_GENERATOR, which computes the generator table instead of including it.
+
+#include "Vanity.h"
+#include "Timer.h"
+
+int main(int argc, char* argv[]) {
+
+	Timer::Init();
+	Int::Init();
+	Secp256K1::Init();
+	Secp256K1::GenerateCode(CPU_GRP_SIZE);
+	return 0;
+
+}
@@ -12,7 +12,7 @@ Int Int::one((uint64_t)1);
 Int Int::zero((uint64_t)0);
 Int Int::factorials[68] = { 0 };
 uint64_t (*Int::LZCFP)(uint64_t) = 0;
-uint64_t (*Int::LZCFP)(uint64_t) = 0;
+uint64_t (*Int::TZCFP)(uint64_t) = 0;
 
 void Int::Init()
 {
@@ -54,6 +54,14 @@ void Int::Init()
 	{
 		TZCFP = _BSF;
 	}
+
+	// Check BMI2 (mulx) and ADX (adcx/adox) support
+	mulxAdx = false;
+	if (numIds >= 7)
+	{
+		__cpuidex(cpuiddata, 7, 0);
+		mulxAdx = ((cpuiddata[1] >> 8) & 0x1) == 1 && ((cpuiddata[1] >> 19) & 0x1) == 1;
+	}
 }
 
 void Int::InitFactorials()
@@ -1062,7 +1070,8 @@ void Int::ShiftL(uint32_t n)
 		{
 			ShiftL64Bit();
 		}
-		shiftL((unsigned char)nb, bits64);
+		if (nb)
+			shiftL((unsigned char)nb, bits64);
 	}
 }
 
@@ -1123,7 +1132,8 @@ void Int::ShiftR(uint32_t n) {
 		{
 			ShiftR64Bit();
 		}
-		shiftR((unsigned char)nb, bits64);
+		if (nb)
+			shiftR((unsigned char)nb, bits64);
 	}
 }
 
@@ -2240,15 +2250,15 @@ void Int::Check()
 	if (Int::GetFieldCharacteristic().IsEqual(b))
 	{
 		// IntGroup -----------------------------------------------------------------------------------
-		Int m[256];
+		IntK1 m[256];
 		Int chk[256];
 		IntGroup g(256);
 
 		g.Set(m);
 		for (int i = 0; i < 256; i++)
 		{
-			m[i].Rand(pSize);
-			chk[i].Set(m[i]);
+			chk[i].Rand(pSize);
+			m[i].Set(chk[i]);
 			chk[i].ModInv();
 		}
 		g.ModInv();
@@ -2258,8 +2268,9 @@ void Int::Check()
 			if (!m[i].IsEqual(chk[i]))
 			{
 				ok = false;
+				m[i].Get(a);
 				printf("IntGroup.ModInv() Wrong !\n");
-				printf("[%d] %s\n", i, m[i].GetBase16().c_str());
+				printf("[%d] %s\n", i, a.GetBase16().c_str());
 				printf("[%d] %s\n", i, chk[i].GetBase16().c_str());
 				return;
 			}
@@ -2270,7 +2281,8 @@ void Int::Check()
 		{
 			for (int i = 0; i < 256; i++)
 			{
-				m[i].Rand(pSize);
+				a.Rand(pSize);
+				m[i].Set(a);
 			}
 			g.ModInv();
 		}
@@ -2279,104 +2291,202 @@ void Int::Check()
 		printf("IntGroup.ModInv() Results OK : ");
 		Timer::printResult((char*)"Inv", 1000 * 256, 0, t1 - t0);
 
-		// ModMulK1 ------------------------------------------------------------------------------------
-
-		for (int i = 0; i < 100000; i++)
+		// Generic and MULX/ADX (if supported) SecpK1 multiplications
+		bool adx = mulxAdx;
+		for (int path = 0; path < (adx ? 2 : 1); path++)
 		{
+			mulxAdx = (path == 1);
+			const char* pName = mulxAdx ? " (mulx/adx)" : "";
+
+			// ModMulK1 ------------------------------------------------------------------------------------
+
+			for (int i = 0; i < 100000; i++)
+			{
+				a.Rand(pSize);
+				b.Rand(pSize);
+				c.ModMul(a, b);
+				d.ModMulK1(a, b);
+				if (!c.IsEqual(d))
+				{
+					printf("ModMulK1()%s Wrong !\n", pName);
+					printf("[%d] %s\n", i, c.GetBase16().c_str());
+					printf("[%d] %s\n", i, d.GetBase16().c_str());
+					return;
+				}
+			}
+
 			a.Rand(pSize);
 			b.Rand(pSize);
-			c.ModMul(a, b);
-			d.ModMulK1(a, b);
-			if (!c.IsEqual(d))
+			t0 = Timer::get_tick();
+			for (int i = 0; i < 1000000; i++)
 			{
-				printf("ModMulK1() Wrong !\n");
-				printf("[%d] %s\n", i, c.GetBase16().c_str());
-				printf("[%d] %s\n", i, d.GetBase16().c_str());
-				return;
+				a.AddOne();
+				b.AddOne();
+				c.ModMulK1(a, b);
 			}
-		}
+			t1 = Timer::get_tick();
 
-		a.Rand(pSize);
-		b.Rand(pSize);
-		t0 = Timer::get_tick();
-		for (int i = 0; i < 1000000; i++)
-		{
-			a.AddOne();
-			b.AddOne();
-			c.ModMulK1(a, b);
-		}
-		t1 = Timer::get_tick();
+			printf("ModMulK1()%s Results OK : ", pName);
+			Timer::printResult((char*)"Mult", 1000000, 0, t1 - t0);
 
-		printf("ModMulK1() Results OK : ");
-		Timer::printResult((char*)"Mult", 1000000, 0, t1 - t0);
+			// ModSqrK1 ------------------------------------------------------------------------------------
 
-		// ModSqrK1 ------------------------------------------------------------------------------------
+			for (int i = 0; i < 100000; i++)
+			{
+				a.Rand(pSize);
+				c.ModMul(a, a);
+				d.ModSquareK1(a);
+				if (!c.IsEqual(d))
+				{
+					printf("ModSquareK1()%s Wrong !\n", pName);
+					printf("[%d] %s\n", i, c.GetBase16().c_str());
+					printf("[%d] %s\n", i, d.GetBase16().c_str());
+					return;
+				}
+			}
 
-		for (int i = 0; i < 100000; i++)
-		{
 			a.Rand(pSize);
-			c.ModMul(a, a);
-			d.ModSquareK1(a);
-			if (!c.IsEqual(d))
+			b.Rand(pSize);
+			t0 = Timer::get_tick();
+			for (int i = 0; i < 1000000; i++)
 			{
-				printf("ModSquareK1() Wrong !\n");
-				printf("[%d] %s\n", i, c.GetBase16().c_str());
-				printf("[%d] %s\n", i, d.GetBase16().c_str());
-				return;
+				a.AddOne();
+				b.AddOne();
+				c.ModSquareK1(b);
 			}
-		}
+			t1 = Timer::get_tick();
 
-		a.Rand(pSize);
-		b.Rand(pSize);
-		t0 = Timer::get_tick();
-		for (int i = 0; i < 1000000; i++)
-		{
-			a.AddOne();
-			b.AddOne();
-			c.ModSquareK1(b);
-		}
-		t1 = Timer::get_tick();
+			printf("ModSquareK1()%s Results OK : ", pName);
+			Timer::printResult((char*)"Sqr", 1000000, 0, t1 - t0);
 
-		printf("ModSquareK1() Results OK : ");
-		Timer::printResult((char*)"Sqr", 1000000, 0, t1 - t0);
+			// modInvCost is for 200000 iterations
+			double cost = movInvCost * 5.0 / (t1 - t0);
+			printf("ModInv() Cost : %.1f S\n", cost);
 
-		// modInvCost is for 200000 iterations
-		double cost = movInvCost * 5.0 / (t1 - t0);
-		printf("ModInv() Cost : %.1f S\n", cost);
+			// ModMulK1 order -----------------------------------------------------------------------------
+			// InitK1() is done by secpK1
+			b.SetBase16((char*)"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+			Int::SetupField(b);
 
-		// ModMulK1 order -----------------------------------------------------------------------------
-		// InitK1() is done by secpK1
-		b.SetBase16((char*)"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
-		Int::SetupField(b);
+			for (int i = 0; i < 100000; i++)
+			{
+				a.Rand(pSize);
+				b.Rand(pSize);
+				c.ModMul(a, b);
+				d.Set(a);
+				d.ModMulK1order(b);
+				if (!c.IsEqual(d))
+				{
+					printf("ModMulK1order()%s Wrong !\n", pName);
+					printf("[%d] %s\n", i, c.GetBase16().c_str());
+					printf("[%d] %s\n", i, d.GetBase16().c_str());
+					return;
+				}
+			}
 
-		for (int i = 0; i < 100000; i++)
+			t0 = Timer::get_tick();
+			for (int i = 0; i < 1000000; i++)
+			{
+				a.Rand(pSize);
+				b.Rand(pSize);
+				c.Set(a);
+				c.ModMulK1order(b);
+			}
+			t1 = Timer::get_tick();
+
+			printf("ModMulK1order()%s Results OK : ", pName);
+			Timer::printResult((char*)"Mult", 1000000, 0, t1 - t0);
+
+			// Restore SecpK1 prime
+			b.SetBase16((char*)"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+			Int::SetupField(b);
+		}
+		mulxAdx = adx;
+
+		// Lazy reduction (ModAddK1, ModSubK1, ModNegK1, ModNormK1) -----------------------------------
+		// Operands span [0,2^256) and include the values which trigger the second carry
+		// (a+b >= 2^257-K) and the second borrow (b-a > P), K = 2^256-P. Results must be
+		// < 2^256 and congruent to the fully reduced ModAdd/ModSub/ModNeg.
+		Int P = GetFieldCharacteristic();
+		Int K, zero, e, f;
+		Int edges[12];
+		K.SetBase16((char*)"1000003D1");
+		zero.SetInt32(0);
+		edges[0].SetInt32(0);
+		edges[1].SetInt32(1);
+		edges[2].Set(K); edges[2].SubOne();
+		edges[3].Set(K);
+		edges[4].Set(K); edges[4].AddOne();
+		edges[5].Set(P); edges[5].SubOne();
+		edges[6].Set(P);
+		edges[7].Set(P); edges[7].AddOne();
+		edges[8].Set(P); edges[8].Add(K); edges[8].Sub((uint64_t)2);	// 2^256-2
+		edges[9].Set(P); edges[9].Add(K); edges[9].SubOne();	// 2^256-1
+		edges[10].SetBase16((char*)"8000000000000000000000000000000000000000000000000000000000000000");
+		edges[11].Set(P); edges[11].Sub(K);						// 2^256-2K
+
+		for (int i = 0; i < 100000 + 12 * 12; i++)
 		{
-			a.Rand(pSize);
-			b.Rand(pSize);
-			c.ModMul(a, b);
-			d.Set(a);
-			d.ModMulK1order(b);
-			if (!c.IsEqual(d))
+			if (i < 12 * 12)
 			{
-				printf("ModMulK1order() Wrong !\n");
-				printf("[%d] %s\n", i, c.GetBase16().c_str());
-				printf("[%d] %s\n", i, d.GetBase16().c_str());
-				return;
+				a.Set(edges[i / 12]);
+				b.Set(edges[i % 12]);
+			}
+			else
+			{
+				a.Rand(256);
+				b.Rand(256);
+			}
+			// Fully reduced operands
+			e.Set(a);
+			if (e.IsGreaterOrEqual(P)) e.Sub(P);
+			f.Set(b);
+			if (f.IsGreaterOrEqual(P)) f.Sub(P);
+
+			for (int op = 0; op < 4; op++)
+			{
+				switch (op)
+				{
+					case 0: c.ModAdd(e, f); d.ModAddK1(a, b); break;
+					case 1: c.ModSub(e, f); d.ModSubK1(a, b); break;
+					case 2: c.ModSub(zero, e); d.Set(a); d.ModNegK1(); break;
+					case 3: c.Set(e); d.Set(a); break;
+				}
+				bool inRange = (d.bits64[4] == 0);
+				d.ModNormK1();
+				if (!inRange || !d.IsLower(P) || !c.IsEqual(d))
+				{
+					printf("Lazy reduction op %d Wrong !\n", op);
+					printf("[%d] %s\n", i, a.GetBase16().c_str());
+					printf("[%d] %s\n", i, b.GetBase16().c_str());
+					printf("[%d] %s\n", i, c.GetBase16().c_str());
+					printf("[%d] %s\n", i, d.GetBase16().c_str());
+					return;
+				}
 			}
 		}
 
+		a.Rand(P);
+		b.Rand(P);
 		t0 = Timer::get_tick();
 		for (int i = 0; i < 1000000; i++)
 		{
-			a.Rand(pSize);
-			b.Rand(pSize);
-			c.Set(a);
-			c.ModMulK1order(b);
+			c.ModSub(a, b);
+			a.ModAdd(c);
 		}
 		t1 = Timer::get_tick();
+		printf("ModSub()/ModAdd() : ");
+		Timer::printResult((char*)"Op", 2000000, 0, t1 - t0);
 
-		printf("ModMulK1order() Results OK : ");
-		Timer::printResult((char*)"Mult", 1000000, 0, t1 - t0);
+		t0 = Timer::get_tick();
+		for (int i = 0; i < 1000000; i++)
+		{
+			c.ModSubK1(a, b);
+			a.ModAddK1(c);
+		}
+		t1 = Timer::get_tick();
+		printf("ModSubK1()/ModAddK1() (lazy) Results OK : ");
+		Timer::printResult((char*)"Op", 2000000, 0, t1 - t0);
 	}
 
 	// Restore Secp256K1 prime
@@ -198,6 +198,13 @@ public:
 	void ModMulK1(const Int& a, const Int& b);
 	void ModMulK1(const Int& a);
 	void ModSquareK1(const Int& a);
+	// Lazy reduction, operands and results in [0,2^256) (not necessarily < P)
+	void ModAddK1(const Int& a, const Int& b);			// this <- a+b (mod P)
+	void ModAddK1(const Int& a);						// this <- this+a (mod P)
+	void ModSubK1(const Int& a, const Int& b);			// this <- a-b (mod P)
+	void ModSubK1(const Int& a);						// this <- this-a (mod P)
+	void ModNegK1();									// this <- -this (mod P)
+	void ModNormK1();									// this <- this (mod P), fully reduced
 	void ModMulK1order(const Int& a);
 	void ModAddK1order(const Int& a, const Int& b);
 	void ModAddK1order(const Int& a);
@@ -264,6 +271,8 @@ public:
 	static void Init();
 	static void InitFactorials();
 
+	static bool mulxAdx;								// MULX/ADX SecpK1 multiplications (set by Init())
+
 private:
 	static Int factorials[68];
 
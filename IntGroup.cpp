@@ -16,47 +16,126 @@
 */
 
 #include "IntGroup.h"
+#include "IntMod4.h"
+#include "IntMod8.h"
 
 using namespace std;
 
-IntGroup::IntGroup(int size)
+// Independent chains of the scalar path (enough to cover the ModMulK1 latency)
+#define NBCHAIN_SCALAR 4
+
+IntGroup::IntGroup(int size, int fieldBackend)
 {
     this->size = size;
-    subp = (Int *)malloc(size * sizeof(Int));
+    subp = new IntK1[size];
+
+    // One chain per lane for the vectorized backends
+    nbChain = (fieldBackend == FIELD_SCALAR) ? NBCHAIN_SCALAR : Secp256K1::GetFieldBackendWidth(fieldBackend);
+    if (nbChain > size)
+    {
+        nbChain = size;
+        fieldBackend = FIELD_SCALAR;
+    }
+    this->fieldBackend = fieldBackend;
 }
 
 IntGroup::~IntGroup()
 {
-    free(subp);
+    delete[] subp;
 }
 
-void IntGroup::Set(Int *pts)
+void IntGroup::Set(IntK1 *pts)
 {
     ints = pts;
 }
 
+// r[j] = a[j]*b[j] for the nbChain lanes of the field backend
+void IntGroup::ModMulT(IntK1 *r, IntK1 *a, IntK1 *b)
+{
+    uint64_t *_r[8];
+    uint64_t *_a[8];
+    uint64_t *_b[8];
+
+    for (int j = 0; j < nbChain; j++)
+    {
+        _r[j] = r[j].bits64;
+        _a[j] = a[j].bits64;
+        _b[j] = b[j].bits64;
+    }
+
+    switch (fieldBackend)
+    {
+    case FIELD_AVX2:
+        ModMulK1x4(_r, _a, _b);
+        break;
+    case FIELD_IFMA:
+        ModMulK1x8(_r, _a, _b);
+        break;
+    }
+}
+
 // Compute modular inversion of the whole group
+// The group and the prefix products are kept in compact form (IntK1),
+// only the inversion of the chain products is done on Int
 void IntGroup::ModInv()
 {
-    Int newValue;
     Int inverse;
+    Int v;
+    IntK1 inv[8];
+    IntK1 tmp[8];
+    int c;
+    int i;
 
-    subp[0].Set(ints[0]);
-    for (int i = 1; i < size; i++)
+    // [nbChain,m) is made of whole blocks of nbChain elements (one per chain)
+    int m = nbChain + ((size - nbChain) / nbChain) * nbChain;
+    bool simd = (fieldBackend != FIELD_SCALAR);
+
+    // Prefix products of each chain: subp[i] = ints[i % nbChain] * ... * ints[i]
+    for (i = 0; i < nbChain; i++)
+        subp[i] = ints[i];
+    i = nbChain;
+    if (simd)
     {
-        subp[i].ModMulK1(subp[i - 1], ints[i]);
+        for (; i < m; i += nbChain)
+            ModMulT(subp + i, subp + i - nbChain, ints + i);
     }
+    for (; i < size; i++)
+        subp[i].ModMulK1(subp[i - nbChain], ints[i]);
+
+    // Inverse of the chain products (last element of each chain), one ModInv
+    tmp[0] = subp[((size - 1) / nbChain) * nbChain];
+    for (c = 1; c < nbChain; c++)
+        tmp[c].ModMulK1(tmp[c - 1], subp[c + ((size - 1 - c) / nbChain) * nbChain]);
 
-    // Do the inversion
-    inverse.Set(subp[size - 1]);
+    tmp[nbChain - 1].Get(inverse);
     inverse.ModInv();
+    inv[0].Set(inverse);
 
-    for (int i = size - 1; i > 0; i--)
+    for (c = nbChain - 1; c > 0; c--)
+    {
+        inv[c].ModMulK1(tmp[c - 1], inv[0]);
+        inv[0].ModMulK1(inv[0], subp[c + ((size - 1 - c) / nbChain) * nbChain]);
+    }
+
+    // Back substitution, chain of element i is i % nbChain
+    for (i = size - 1; i >= (simd ? m : nbChain); i--)
+    {
+        c = i % nbChain;
+        tmp[c].ModMulK1(subp[i - nbChain], inv[c]);
+        inv[c].ModMulK1(inv[c], ints[i]);
+        ints[i] = tmp[c];
+    }
+    if (simd)
     {
-        newValue.ModMulK1(subp[i - 1], inverse);
-        inverse.ModMulK1(ints[i]);
-        ints[i].Set(newValue);
+        for (i = m - nbChain; i >= nbChain; i -= nbChain)
+        {
+            ModMulT(tmp, subp + i - nbChain, inv);
+            ModMulT(inv, inv, ints + i);
+            for (c = 0; c < nbChain; c++)
+                ints[i + c] = tmp[c];
+        }
     }
 
-    ints[0].Set(inverse);
+    for (c = 0; c < nbChain; c++)
+        ints[c] = inv[c];
 }
\ No newline at end of file
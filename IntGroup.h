@@ -18,21 +18,29 @@
 #ifndef INTGROUPH
 #define INTGROUPH
 
-#include "Int.h"
+#include "IntK1.h"
+#include "SECP256k1.h"
 #include <vector>
 
+// Batch modular inversion (Montgomery trick). The group is split into interleaved
+// chains (element i belongs to chain i % nbChain) whose products are independent:
+// the scalar multiplications overlap in the pipeline and a vectorized field backend
+// (FIELD_AVX2, FIELD_IFMA) runs one chain per lane.
 class IntGroup
 {
 public:
-	IntGroup(int size);
+	IntGroup(int size, int fieldBackend = FIELD_SCALAR);
 	~IntGroup();
-	void Set(Int *pts);
+	void Set(IntK1 *pts);
 	void ModInv();
 
 private:
-	Int *ints;
-	Int *subp;
+	void ModMulT(IntK1 *r, IntK1 *a, IntK1 *b);
+	IntK1 *ints;
+	IntK1 *subp;
 	int size;
+	int nbChain;
+	int fieldBackend;
 };
 
-#endif // INTGROUPCPUH
+#endif // INTGROUPCPUH
\ No newline at end of file
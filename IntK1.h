@@ -0,0 +1,73 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTK1H
+#define INTK1H
+
+#include "Int.h"
+
+#ifdef WIN64
+#define K1ALIGN(n) __declspec(align(n))
+#else
+#define K1ALIGN(n) __attribute__((aligned(n)))
+#endif
+
+// Compact secp256k1 field element for hot path storage (group walk, IntGroup,
+// generator tables): 4x64 bits words, no extra Knuth block, 32 bytes aligned so
+// that an element is one AVX2 load and 2 elements fit in a cache line.
+// Values are < 2^256 (as left by Int::ModMulK1), arithmetic is done on Int
+// except for the products of the batch inversion.
+
+class K1ALIGN(32) IntK1 {
+
+public:
+
+	void Set(const Int& a) {
+		bits64[0] = a.bits64[0];
+		bits64[1] = a.bits64[1];
+		bits64[2] = a.bits64[2];
+		bits64[3] = a.bits64[3];
+	}
+
+	void Get(Int& r) const {
+		r.bits64[0] = bits64[0];
+		r.bits64[1] = bits64[1];
+		r.bits64[2] = bits64[2];
+		r.bits64[3] = bits64[3];
+		r.bits64[4] = 0;
+	}
+
+	bool IsEqual(const Int& a) const {
+		return (bits64[0] == a.bits64[0]) && (bits64[1] == a.bits64[1]) &&
+			(bits64[2] == a.bits64[2]) && (bits64[3] == a.bits64[3]) && (a.bits64[4] == 0);
+	}
+
+	bool IsOdd() const { return (bits64[0] & 1) == 1; }
+
+	void ModMulK1(const IntK1& a, const IntK1& b);		// this <- a*b (mod P), see Int::ModMulK1
+
+	union
+	{
+		uint8_t  bits08[32];
+		uint16_t bits16[16];
+		uint32_t bits32[8];
+		uint64_t bits64[4];
+	};
+
+};
+
+#endif // INTK1H
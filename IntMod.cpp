@@ -915,8 +915,602 @@ void Int::MontgomeryMult(const Int& a, const Int& b)
 
 // SecpK1 specific section -----------------------------------------------------------------------------
 
+static Int _R2o;								// R^2 for SecpK1 order modular mult
+static uint64_t MM64o = 0x4B0DFF665588B13FULL;	// 64bits lsb negative inverse of SecpK1 order
+static const Int* _O;							// SecpK1 order
+
+// MULX/ADX section ------------------------------------------------------------------------------
+// 4x64 bits products using mulx (flags untouched) and two independent carry chains:
+// adcx (CF) accumulates the low halves and adox (OF) the high halves of a row.
+// Same reduction as the generic code, results are not fully reduced (< 2^256).
+
+bool Int::mulxAdx = false;
+
+// Copy of the SecpK1 order (*_O) addressable without a register
+static const uint64_t _On[4] = { 0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL };
+
+#ifndef WIN64
+
+// r = a*b (mod P)
+static void ModMulK1ADX(uint64_t* r, const uint64_t* a, const uint64_t* b)
+{
+	__asm__ __volatile__(
+		"movq 0(%[b]), %%rdx\n\t"
+		"mulxq 0(%[a]), %%r8, %%r9\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r10\n\t"
+		"addq %%rbx, %%r9\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r11\n\t"
+		"adcq %%rbx, %%r10\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r12\n\t"
+		"adcq %%rbx, %%r11\n\t"
+		"adcq $0, %%r12\n\t"
+		"movq 8(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r13, %%r10\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r13, %%r11\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r13, %%r12\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%rax, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"movq 16(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%rax, %%r14\n\t"
+		"adcxq %%rax, %%r14\n\t"
+		"movq 24(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r15, %%r12\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r15, %%r13\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%r15, %%r14\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r14\n\t"
+		"adoxq %%rax, %%r15\n\t"
+		"adcxq %%rax, %%r15\n\t"
+		"movq $0x1000003D1, %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %%r12, %%rbx, %%r12\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r12, %%r9\n\t"
+		"mulxq %%r13, %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r13, %%r10\n\t"
+		"mulxq %%r14, %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq %%r15, %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%rax, %%r15\n\t"
+		"adcxq %%rax, %%r15\n\t"
+		"mulxq %%r15, %%rbx, %%r15\n\t"
+		"addq %%rbx, %%r8\n\t"
+		"adcq %%r15, %%r9\n\t"
+		"adcq $0, %%r10\n\t"
+		"adcq $0, %%r11\n\t"
+		"movq %%r8, 0(%[r])\n\t"
+		"movq %%r9, 8(%[r])\n\t"
+		"movq %%r10, 16(%[r])\n\t"
+		"movq %%r11, 24(%[r])\n\t"
+		:
+		: [r] "r"(r), [a] "r"(a), [b] "r"(b)
+		: "rax", "rbx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+}
+
+// r = a^2 (mod P)
+static void ModSquareK1ADX(uint64_t* r, const uint64_t* a)
+{
+	__asm__ __volatile__(
+		"movq 0(%[a]), %%rdx\n\t"
+		"mulxq 8(%[a]), %%r9, %%r10\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r11\n\t"
+		"addq %%rbx, %%r10\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r12\n\t"
+		"adcq %%rbx, %%r11\n\t"
+		"adcq $0, %%r12\n\t"
+		"movq 8(%[a]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r8\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r8, %%r12\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%rax, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"movq 16(%[a]), %%rdx\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"addq %%rbx, %%r13\n\t"
+		"adcq $0, %%r14\n\t"
+		"movq 0(%[a]), %%rdx\n\t"
+		"mulxq %%rdx, %%r8, %%r15\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"adcxq %%r9, %%r9\n\t"
+		"adoxq %%r15, %%r9\n\t"
+		"movq 8(%[a]), %%rdx\n\t"
+		"mulxq %%rdx, %%rbx, %%r15\n\t"
+		"adcxq %%r10, %%r10\n\t"
+		"adoxq %%rbx, %%r10\n\t"
+		"adcxq %%r11, %%r11\n\t"
+		"adoxq %%r15, %%r11\n\t"
+		"movq 16(%[a]), %%rdx\n\t"
+		"mulxq %%rdx, %%rbx, %%r15\n\t"
+		"adcxq %%r12, %%r12\n\t"
+		"adoxq %%rbx, %%r12\n\t"
+		"adcxq %%r13, %%r13\n\t"
+		"adoxq %%r15, %%r13\n\t"
+		"movq 24(%[a]), %%rdx\n\t"
+		"mulxq %%rdx, %%rbx, %%r15\n\t"
+		"adcxq %%r14, %%r14\n\t"
+		"adoxq %%rbx, %%r14\n\t"
+		"adcxq %%rax, %%r15\n\t"
+		"adoxq %%rax, %%r15\n\t"
+		"movq $0x1000003D1, %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %%r12, %%rbx, %%r12\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r12, %%r9\n\t"
+		"mulxq %%r13, %%rbx, %%r13\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r13, %%r10\n\t"
+		"mulxq %%r14, %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq %%r15, %%rbx, %%r15\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%rax, %%r15\n\t"
+		"adcxq %%rax, %%r15\n\t"
+		"mulxq %%r15, %%rbx, %%r15\n\t"
+		"addq %%rbx, %%r8\n\t"
+		"adcq %%r15, %%r9\n\t"
+		"adcq $0, %%r10\n\t"
+		"adcq $0, %%r11\n\t"
+		"movq %%r8, 0(%[r])\n\t"
+		"movq %%r9, 8(%[r])\n\t"
+		"movq %%r10, 16(%[r])\n\t"
+		"movq %%r11, 24(%[r])\n\t"
+		:
+		: [r] "r"(r), [a] "r"(a)
+		: "rax", "rbx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+}
+
+// r = a*b/2^256 (mod order), Montgomery product (CIOS), r < order
+static void MontMulK1orderADX(uint64_t* r, const uint64_t* a, const uint64_t* b)
+{
+	__asm__ __volatile__(
+		"xorl %%r8d, %%r8d\n\t"
+		"xorl %%r9d, %%r9d\n\t"
+		"xorl %%r10d, %%r10d\n\t"
+		"xorl %%r11d, %%r11d\n\t"
+		"xorl %%r12d, %%r12d\n\t"
+		"xorl %%r13d, %%r13d\n\t"
+		"movq 0(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r14, %%r9\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r14, %%r10\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"adcxq %%rax, %%r12\n\t"
+		"adoxq %%rax, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"movq %%r8, %%rdx\n\t"
+		"imulq %[m], %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %[n0], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r14, %%r9\n\t"
+		"mulxq %[n1], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r14, %%r10\n\t"
+		"mulxq %[n2], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq %[n3], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"adcxq %%rax, %%r12\n\t"
+		"adoxq %%rax, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"xorl %%r8d, %%r8d\n\t"
+		"movq 8(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r14, %%r10\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"adoxq %%rax, %%r8\n\t"
+		"adcxq %%rax, %%r8\n\t"
+		"movq %%r9, %%rdx\n\t"
+		"imulq %[m], %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %[n0], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r9\n\t"
+		"adoxq %%r14, %%r10\n\t"
+		"mulxq %[n1], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq %[n2], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq %[n3], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"adcxq %%rax, %%r13\n\t"
+		"adoxq %%rax, %%r8\n\t"
+		"adcxq %%rax, %%r8\n\t"
+		"xorl %%r9d, %%r9d\n\t"
+		"movq 16(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%r14, %%r8\n\t"
+		"adcxq %%rax, %%r8\n\t"
+		"adoxq %%rax, %%r9\n\t"
+		"adcxq %%rax, %%r9\n\t"
+		"movq %%r10, %%rdx\n\t"
+		"imulq %[m], %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %[n0], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r10\n\t"
+		"adoxq %%r14, %%r11\n\t"
+		"mulxq %[n1], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq %[n2], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"mulxq %[n3], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%r14, %%r8\n\t"
+		"adcxq %%rax, %%r8\n\t"
+		"adoxq %%rax, %%r9\n\t"
+		"adcxq %%rax, %%r9\n\t"
+		"xorl %%r10d, %%r10d\n\t"
+		"movq 24(%[b]), %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq 0(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq 8(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"mulxq 16(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%r14, %%r8\n\t"
+		"mulxq 24(%[a]), %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r14, %%r9\n\t"
+		"adcxq %%rax, %%r9\n\t"
+		"adoxq %%rax, %%r10\n\t"
+		"adcxq %%rax, %%r10\n\t"
+		"movq %%r11, %%rdx\n\t"
+		"imulq %[m], %%rdx\n\t"
+		"xorl %%eax, %%eax\n\t"
+		"mulxq %[n0], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r11\n\t"
+		"adoxq %%r14, %%r12\n\t"
+		"mulxq %[n1], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r12\n\t"
+		"adoxq %%r14, %%r13\n\t"
+		"mulxq %[n2], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r13\n\t"
+		"adoxq %%r14, %%r8\n\t"
+		"mulxq %[n3], %%rbx, %%r14\n\t"
+		"adcxq %%rbx, %%r8\n\t"
+		"adoxq %%r14, %%r9\n\t"
+		"adcxq %%rax, %%r9\n\t"
+		"adoxq %%rax, %%r10\n\t"
+		"adcxq %%rax, %%r10\n\t"
+		"movq %%r12, %%rax\n\t"
+		"subq %[n0], %%rax\n\t"
+		"movq %%r13, %%rbx\n\t"
+		"sbbq %[n1], %%rbx\n\t"
+		"movq %%r8, %%rdx\n\t"
+		"sbbq %[n2], %%rdx\n\t"
+		"movq %%r9, %%r14\n\t"
+		"sbbq %[n3], %%r14\n\t"
+		"sbbq $0, %%r10\n\t"
+		"cmovncq %%rax, %%r12\n\t"
+		"cmovncq %%rbx, %%r13\n\t"
+		"cmovncq %%rdx, %%r8\n\t"
+		"cmovncq %%r14, %%r9\n\t"
+		"movq %%r12, 0(%[r])\n\t"
+		"movq %%r13, 8(%[r])\n\t"
+		"movq %%r8, 16(%[r])\n\t"
+		"movq %%r9, 24(%[r])\n\t"
+		:
+		: [r] "r"(r), [a] "r"(a), [b] "r"(b), [m] "m"(MM64o),
+		  [n0] "m"(_On[0]), [n1] "m"(_On[1]), [n2] "m"(_On[2]), [n3] "m"(_On[3])
+		: "rax", "rbx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+}
+
+#else
+
+// r = r512 (mod P)
+static void inline ReduceK1ADX(uint64_t* r, const uint64_t* r512)
+{
+	unsigned char c, o;
+	uint64_t t[4];
+	uint64_t lo, hi;
+
+	memcpy(t, r512, 32);
+	c = 0;
+	o = 0;
+	for (int j = 0; j < 4; j++)
+	{
+		lo = _mulx_u64(r512[4 + j], 0x1000003D1ULL, &hi);
+		c = _addcarryx_u64(c, t[j], lo, &t[j]);
+		if (j < 3)
+			o = _addcarryx_u64(o, t[j + 1], hi, &t[j + 1]);
+		else
+			hi += c + o;
+	}
+
+	lo = _mulx_u64(hi, 0x1000003D1ULL, &hi);
+	c = _addcarry_u64(0, t[0], lo, r + 0);
+	c = _addcarry_u64(c, t[1], hi, r + 1);
+	c = _addcarry_u64(c, t[2], 0, r + 2);
+	c = _addcarry_u64(c, t[3], 0, r + 3);
+}
+
+// r = a*b (mod P)
+static void ModMulK1ADX(uint64_t* r, const uint64_t* a, const uint64_t* b)
+{
+	unsigned char c, o;
+	uint64_t r512[8];
+	uint64_t lo, hi;
+
+	r512[0] = _mulx_u64(a[0], b[0], &r512[1]);
+	lo = _mulx_u64(a[1], b[0], &r512[2]);
+	c = _addcarryx_u64(0, r512[1], lo, &r512[1]);
+	lo = _mulx_u64(a[2], b[0], &r512[3]);
+	c = _addcarryx_u64(c, r512[2], lo, &r512[2]);
+	lo = _mulx_u64(a[3], b[0], &r512[4]);
+	c = _addcarryx_u64(c, r512[3], lo, &r512[3]);
+	_addcarryx_u64(c, r512[4], 0, &r512[4]);
+
+	for (int i = 1; i < 4; i++)
+	{
+		c = 0;
+		o = 0;
+		for (int j = 0; j < 4; j++)
+		{
+			lo = _mulx_u64(a[j], b[i], &hi);
+			c = _addcarryx_u64(c, r512[i + j], lo, &r512[i + j]);
+			if (j < 3)
+				o = _addcarryx_u64(o, r512[i + j + 1], hi, &r512[i + j + 1]);
+			else
+				r512[i + 4] = hi + c + o;
+		}
+	}
+
+	ReduceK1ADX(r, r512);
+}
+
+// r = a^2 (mod P)
+static void ModSquareK1ADX(uint64_t* r, const uint64_t* a)
+{
+	ModMulK1ADX(r, a, a);
+}
+
+// r = a*b/2^256 (mod order), Montgomery product (CIOS), r < order
+static void MontMulK1orderADX(uint64_t* r, const uint64_t* a, const uint64_t* b)
+{
+	unsigned char c, o;
+	uint64_t t[6] = { 0 };
+	uint64_t u[4];
+	uint64_t lo, hi, m;
+
+	for (int i = 0; i < 4; i++)
+	{
+		t[5] = 0;
+		c = 0;
+		o = 0;
+		for (int j = 0; j < 4; j++)
+		{
+			lo = _mulx_u64(a[j], b[i], &hi);
+			c = _addcarryx_u64(c, t[j], lo, &t[j]);
+			o = _addcarryx_u64(o, t[j + 1], hi, &t[j + 1]);
+		}
+		c = _addcarryx_u64(c, t[4], 0, &t[4]);
+		t[5] += c + o;
+
+		m = t[0] * MM64o;
+		c = 0;
+		o = 0;
+		for (int j = 0; j < 4; j++)
+		{
+			lo = _mulx_u64(_On[j], m, &hi);
+			c = _addcarryx_u64(c, t[j], lo, &t[j]);
+			o = _addcarryx_u64(o, t[j + 1], hi, &t[j + 1]);
+		}
+		c = _addcarryx_u64(c, t[4], 0, &t[4]);
+		t[5] += c + o;
+
+		memmove(t, t + 1, 5 * 8);
+	}
+
+	c = _subborrow_u64(0, t[0], _On[0], &u[0]);
+	c = _subborrow_u64(c, t[1], _On[1], &u[1]);
+	c = _subborrow_u64(c, t[2], _On[2], &u[2]);
+	c = _subborrow_u64(c, t[3], _On[3], &u[3]);
+	c = _subborrow_u64(c, t[4], 0, &t[4]);
+	memcpy(r, c ? t : u, 32);
+}
+
+#endif
+
+// Lazy reduction section ------------------------------------------------------------------------
+// Operands and results are in [0,2^256) (bits64[4] = 0), congruent to the field value
+// but not necessarily < P, the range left by ModMulK1 and ModSquareK1 which accept it.
+// 4 words only, a carry (borrow) is folded by adding (subtracting) K = 2^256 - P.
+// Add: on carry r = a+b-2^256 and r+K = a+b-P. A second carry means r+K-2^256 < K,
+//      adding K again gives a+b-2P < 2K, no third carry.
+// Sub: on borrow r = a-b+2^256 >= 1 and r-K = a-b+P. A second borrow means r < K,
+//      r-K+2^256 >= 2^256-K > K, subtracting K again gives a-b+2P, no third borrow.
+// The folds are branches: the first one is taken half of the time but is speculated,
+// masked folds put the 4 words on the dependency chain and were slower.
+// The second one requires an operand >= P and is almost never taken.
+
+#define K1 0x1000003D1ULL
+
+void Int::ModAddK1(const Int& a, const Int& b)
+{
+	unsigned char c;
+
+	c = _addcarry_u64(0, a.bits64[0], b.bits64[0], bits64 + 0);
+	c = _addcarry_u64(c, a.bits64[1], b.bits64[1], bits64 + 1);
+	c = _addcarry_u64(c, a.bits64[2], b.bits64[2], bits64 + 2);
+	c = _addcarry_u64(c, a.bits64[3], b.bits64[3], bits64 + 3);
+
+	if (c)
+	{
+		c = _addcarry_u64(0, bits64[0], K1, bits64 + 0);
+		c = _addcarry_u64(c, bits64[1], 0, bits64 + 1);
+		c = _addcarry_u64(c, bits64[2], 0, bits64 + 2);
+		c = _addcarry_u64(c, bits64[3], 0, bits64 + 3);
+		// this < K, no propagation
+		if (c)
+			bits64[0] += K1;
+	}
+	bits64[4] = 0;
+}
+
+void Int::ModAddK1(const Int& a)
+{
+	ModAddK1(*this, a);
+}
+
+static void inline ModSubK1(uint64_t* r, const uint64_t* a, const uint64_t* b)
+{
+	unsigned char c;
+
+	c = _subborrow_u64(0, a[0], b[0], r + 0);
+	c = _subborrow_u64(c, a[1], b[1], r + 1);
+	c = _subborrow_u64(c, a[2], b[2], r + 2);
+	c = _subborrow_u64(c, a[3], b[3], r + 3);
+
+	if (c)
+	{
+		c = _subborrow_u64(0, r[0], K1, r + 0);
+		c = _subborrow_u64(c, r[1], 0, r + 1);
+		c = _subborrow_u64(c, r[2], 0, r + 2);
+		c = _subborrow_u64(c, r[3], 0, r + 3);
+		if (c)
+		{
+			c = _subborrow_u64(0, r[0], K1, r + 0);
+			c = _subborrow_u64(c, r[1], 0, r + 1);
+			c = _subborrow_u64(c, r[2], 0, r + 2);
+			c = _subborrow_u64(c, r[3], 0, r + 3);
+		}
+	}
+	r[4] = 0;
+}
+
+void Int::ModSubK1(const Int& a, const Int& b)
+{
+	::ModSubK1(bits64, a.bits64, b.bits64);
+}
+
+void Int::ModSubK1(const Int& a)
+{
+	::ModSubK1(bits64, bits64, a.bits64);
+}
+
+void Int::ModNegK1()
+{
+	static const uint64_t zero[4] = { 0ULL,0ULL,0ULL,0ULL };
+	::ModSubK1(bits64, zero, bits64);
+}
+
+void Int::ModNormK1()
+{
+	// this >= P <=> this + K >= 2^256, only possible when the 3 upper words are all ones
+	bits64[4] = 0;
+	if ((bits64[3] & bits64[2] & bits64[1]) != 0xFFFFFFFFFFFFFFFFULL)
+		return;
+
+	unsigned char c;
+	uint64_t t[4];
+	c = _addcarry_u64(0, bits64[0], K1, t + 0);
+	c = _addcarry_u64(c, bits64[1], 0, t + 1);
+	c = _addcarry_u64(c, bits64[2], 0, t + 2);
+	c = _addcarry_u64(c, bits64[3], 0, t + 3);
+	if (c)
+	{
+		bits64[0] = t[0];
+		bits64[1] = t[1];
+		bits64[2] = t[2];
+		bits64[3] = t[3];
+	}
+}
+
+#undef K1
+
+// -----------------------------------------------------------------------------------------------
+
+
 void Int::ModMulK1(const Int& a, const Int& b)
 {
+	if (mulxAdx)
+	{
+		ModMulK1ADX(bits64, a.bits64, b.bits64);
+		bits64[4] = 0;
+#if BISIZE==512
+		bits64[5] = 0;
+		bits64[6] = 0;
+		bits64[7] = 0;
+		bits64[8] = 0;
+#endif
+		return;
+	}
+
 #ifndef WIN64
 #if (__GNUC__ > 7) || (__GNUC__ == 7 && (__GNUC_MINOR__ > 2))
 	unsigned char c;
@@ -995,6 +1589,19 @@ void Int::ModMulK1(const Int& a, const Int& b)
 
 void Int::ModMulK1(const Int& a)
 {
+	if (mulxAdx)
+	{
+		ModMulK1ADX(bits64, a.bits64, bits64);
+		bits64[4] = 0;
+#if BISIZE==512
+		bits64[5] = 0;
+		bits64[6] = 0;
+		bits64[7] = 0;
+		bits64[8] = 0;
+#endif
+		return;
+	}
+
 #ifndef WIN64
 #if (__GNUC__ > 7) || (__GNUC__ == 7 && (__GNUC_MINOR__ > 2))
 	unsigned char c;
@@ -1071,6 +1678,19 @@ void Int::ModMulK1(const Int& a)
 
 void Int::ModSquareK1(const Int& a)
 {
+	if (mulxAdx)
+	{
+		ModSquareK1ADX(bits64, a.bits64);
+		bits64[4] = 0;
+#if BISIZE==512
+		bits64[5] = 0;
+		bits64[6] = 0;
+		bits64[7] = 0;
+		bits64[8] = 0;
+#endif
+		return;
+	}
+
 #ifndef WIN64
 #if (__GNUC__ > 7) || (__GNUC__ == 7 && (__GNUC_MINOR__ > 2))
 	unsigned char c;
@@ -1206,9 +1826,22 @@ void Int::ModSquareK1(const Int& a)
 
 }
 
-static Int _R2o;								// R^2 for SecpK1 order modular mult
-static uint64_t MM64o = 0x4B0DFF665588B13FULL;	// 64bits lsb negative inverse of SecpK1 order
-static const Int* _O;							// SecpK1 order
+// Compact operands (IntK1), the MULX/ADX kernels work on 4 words in place
+void IntK1::ModMulK1(const IntK1& a, const IntK1& b)
+{
+	if (Int::mulxAdx)
+	{
+		ModMulK1ADX(bits64, a.bits64, b.bits64);
+		return;
+	}
+
+	Int _a, _b, r;
+	a.Get(_a);
+	b.Get(_b);
+	r.ModMulK1(_a, _b);
+	Set(r);
+}
+
 
 void Int::InitK1(const Int& order)
 {
@@ -1276,6 +1909,13 @@ void Int::ModMulK1order(const Int& a)
 	uint64_t ML;
 	uint64_t c;
 
+	if (mulxAdx)
+	{
+		MontMulK1orderADX(bits64, a.bits64, bits64);
+		MontMulK1orderADX(bits64, _R2o.bits64, bits64);	// Normalize
+		return;
+	}
+
 	imm_umul((uint64_t*)a.bits64, bits64[0], pr.bits64);
 	ML = pr.bits64[0] * MM64o;
 	imm_umul((uint64_t*)_O->bits64, ML, p.bits64);
@@ -0,0 +1,41 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTMOD4H
+#define INTMOD4H
+
+#include <stdint.h>
+
+// 4-way secp256k1 field arithmetic using AVX2, lane j works on element j.
+// Elements are given as pointers to 4 little endian 64 bits words (Int::bits64).
+// Inputs may be weakly reduced (< 2^256, as left by Int::ModMulK1), outputs are
+// fully reduced (< P, bits64[4] not written).
+// Int.h is not included here: its intrinsic fallbacks clash with immintrin.h,
+// Int/Point wrappers are in Secp256K1.
+
+// r[j] = a[j] * b[j] (mod P), j = 0..3
+void ModMulK1x4(uint64_t *r[4], uint64_t *a[4], uint64_t *b[4]);
+
+// r[j] = a[j]^2 (mod P), j = 0..3
+void ModSquareK1x4(uint64_t *r[4], uint64_t *a[4]);
+
+// Group walk: (pp[j]) = p + g[j] and (pn[j]) = p - g[j] for j = 0..3 (affine),
+// dx[j] must hold 1/(g[j].x - p.x)
+void AddGroup4(uint64_t *px, uint64_t *py, uint64_t *gx[4], uint64_t *gy[4], uint64_t *dx[4],
+               uint64_t *ppx[4], uint64_t *ppy[4], uint64_t *pnx[4], uint64_t *pny[4]);
+
+#endif // INTMOD4H
@@ -0,0 +1,378 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "IntMod4.h"
+#include <immintrin.h>
+
+// Field elements are split in 10 limbs of 26 bits, a limb holds 4 elements (one
+// per 64 bits lane): the 26x26 bits products of _mm256_mul_epu32 and their column
+// sums fit in the lanes. The high half of a product is folded using
+// 2^260 = 2^36 + 0x3D10 (mod P).
+// Limbs are kept below 2^27 between operations (weakly reduced).
+
+namespace _intmod4
+{
+
+  typedef __m256i F[10];
+
+#define M26     _mm256_set1_epi64x(0x3FFFFFF)
+#define ADD(a,b) _mm256_add_epi64(a, b)
+#define SUB(a,b) _mm256_sub_epi64(a, b)
+#define AND(a,b) _mm256_and_si256(a, b)
+#define OR(a,b)  _mm256_or_si256(a, b)
+#define MUL(a,b) _mm256_mul_epu32(a, b)
+#define SHR(a,n) _mm256_srli_epi64(a, n)
+#define SHL(a,n) _mm256_slli_epi64(a, n)
+#define MULR0(a) _mm256_mul_epu32(a, _mm256_set1_epi64x(0x3D10))
+
+  // Propagate the carry of limb k to limb k+1
+#define CARRY(r,k) r[(k) + 1] = ADD(r[(k) + 1], SHR(r[k], 26)); r[k] = AND(r[k], M26);
+
+  // 32*P, limbs >= 2^27 (a + 32P - b stays positive)
+  static const uint64_t P32[10] = {
+    0x7FFF85E0ULL, 0x7FFFF7E0ULL, 0x7FFFFFE0ULL, 0x7FFFFFE0ULL, 0x7FFFFFE0ULL,
+    0x7FFFFFE0ULL, 0x7FFFFFE0ULL, 0x7FFFFFE0ULL, 0x7FFFFFE0ULL, 0x7FFFFE0ULL
+  };
+
+  // 4 elements to limbs
+  static inline void Load(F r, const uint64_t *a0, const uint64_t *a1, const uint64_t *a2, const uint64_t *a3) {
+
+    __m256i w0 = _mm256_setr_epi64x(a0[0], a1[0], a2[0], a3[0]);
+    __m256i w1 = _mm256_setr_epi64x(a0[1], a1[1], a2[1], a3[1]);
+    __m256i w2 = _mm256_setr_epi64x(a0[2], a1[2], a2[2], a3[2]);
+    __m256i w3 = _mm256_setr_epi64x(a0[3], a1[3], a2[3], a3[3]);
+
+    r[0] = AND(w0, M26);
+    r[1] = AND(SHR(w0, 26), M26);
+    r[2] = AND(OR(SHR(w0, 52), SHL(w1, 12)), M26);
+    r[3] = AND(SHR(w1, 14), M26);
+    r[4] = AND(OR(SHR(w1, 40), SHL(w2, 24)), M26);
+    r[5] = AND(SHR(w2, 2), M26);
+    r[6] = AND(SHR(w2, 28), M26);
+    r[7] = AND(OR(SHR(w2, 54), SHL(w3, 10)), M26);
+    r[8] = AND(SHR(w3, 16), M26);
+    r[9] = SHR(w3, 42);
+
+  }
+
+  // Limbs (fully reduced) to 4 elements
+  static inline void Store(F r, uint64_t *a0, uint64_t *a1, uint64_t *a2, uint64_t *a3) {
+
+#ifdef WIN64
+    __declspec(align(32)) uint64_t w[4][4];
+#else
+    uint64_t w[4][4] __attribute__((aligned(32)));
+#endif
+
+    _mm256_store_si256((__m256i *)w[0], OR(OR(r[0], SHL(r[1], 26)), SHL(r[2], 52)));
+    _mm256_store_si256((__m256i *)w[1], OR(OR(SHR(r[2], 12), SHL(r[3], 14)), SHL(r[4], 40)));
+    _mm256_store_si256((__m256i *)w[2], OR(OR(SHR(r[4], 24), SHL(r[5], 2)), OR(SHL(r[6], 28), SHL(r[7], 54))));
+    _mm256_store_si256((__m256i *)w[3], OR(OR(SHR(r[7], 10), SHL(r[8], 16)), SHL(r[9], 42)));
+
+    uint64_t *a[4] = { a0, a1, a2, a3 };
+    for (int j = 0; j < 4; j++) {
+      a[j][0] = w[0][j];
+      a[j][1] = w[1][j];
+      a[j][2] = w[2][j];
+      a[j][3] = w[3][j];
+    }
+
+  }
+
+  // Weak reduction: limbs < 2^27 (input limbs < 2^58, limb 9 < 2^58)
+  static inline void Norm(F r) {
+
+    CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3); CARRY(r, 4);
+    CARRY(r, 5); CARRY(r, 6); CARRY(r, 7); CARRY(r, 8);
+    __m256i c = SHR(r[9], 26);
+    r[9] = AND(r[9], M26);
+    r[0] = ADD(r[0], MULR0(c));
+    r[1] = ADD(r[1], SHL(c, 10));
+    CARRY(r, 0); CARRY(r, 1);
+
+  }
+
+  // Full reduction: 0 <= r < P, limbs < 2^26
+  static inline void Reduce(F r) {
+
+    __m256i m22 = _mm256_set1_epi64x(0x3FFFFF);
+    __m256i c;
+    F t;
+
+    Norm(r);
+    CARRY(r, 2); CARRY(r, 3); CARRY(r, 4); CARRY(r, 5); CARRY(r, 6); CARRY(r, 7); CARRY(r, 8);
+
+    // Fold the bits 256..259 (2^256 = 2^32 + 977), twice as the first fold may carry again
+    for (int i = 0; i < 2; i++) {
+      c = SHR(r[9], 22);
+      r[9] = AND(r[9], m22);
+      r[0] = ADD(r[0], MUL(c, _mm256_set1_epi64x(977)));
+      r[1] = ADD(r[1], SHL(c, 6));
+      CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3); CARRY(r, 4);
+      CARRY(r, 5); CARRY(r, 6); CARRY(r, 7); CARRY(r, 8);
+    }
+
+    // r >= P <=> r + 2^32 + 977 >= 2^256
+    for (int i = 0; i < 10; i++)
+      t[i] = r[i];
+    t[0] = ADD(t[0], _mm256_set1_epi64x(977));
+    t[1] = ADD(t[1], _mm256_set1_epi64x(64));
+    CARRY(t, 0); CARRY(t, 1); CARRY(t, 2); CARRY(t, 3); CARRY(t, 4);
+    CARRY(t, 5); CARRY(t, 6); CARRY(t, 7); CARRY(t, 8);
+    __m256i ge = _mm256_cmpgt_epi64(t[9], m22);
+    t[9] = AND(t[9], m22);
+    for (int i = 0; i < 10; i++)
+      r[i] = _mm256_blendv_epi8(r[i], t[i], ge);
+
+  }
+
+  // Fold the 19 columns of a product (c[19] = 0 on input) into r
+  static inline void MulReduce(F r, __m256i *c) {
+
+    for (int t = 0; t < 19; t++) {
+      CARRY(c, t);
+    }
+
+    // Columns 10..19 weigh 2^260 * 2^(26(t-10)) = (2^36 + 0x3D10) * 2^(26(t-10))
+    r[0] = ADD(c[0], MULR0(c[10]));
+    for (int i = 1; i < 10; i++)
+      r[i] = ADD(ADD(c[i], MULR0(c[i + 10])), SHL(c[i + 9], 10));
+    __m256i r10 = SHL(c[19], 10);
+
+    CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3); CARRY(r, 4);
+    CARRY(r, 5); CARRY(r, 6); CARRY(r, 7); CARRY(r, 8);
+    r10 = ADD(r10, SHR(r[9], 26));
+    r[9] = AND(r[9], M26);
+
+    // r10 < 2^41: split it to keep the multiplier operand on 32 bits
+    __m256i lo = AND(r10, M26);
+    __m256i hi = SHR(r10, 26);
+    r[0] = ADD(r[0], MULR0(lo));
+    r[1] = ADD(r[1], ADD(SHL(lo, 10), MULR0(hi)));
+    r[2] = ADD(r[2], SHL(hi, 10));
+
+    Norm(r);
+
+  }
+
+  // Products are summed column by column (product scanning), fully unrolled
+  static inline void Mul(F r, const F a, const F b) {
+
+    __m256i c[20];
+
+    c[0] = MUL(a[0], b[0]);
+    c[1] = ADD(MUL(a[0], b[1]), MUL(a[1], b[0]));
+    c[2] = ADD(MUL(a[0], b[2]), MUL(a[1], b[1]));
+    c[2] = ADD(c[2], MUL(a[2], b[0]));
+    c[3] = ADD(MUL(a[0], b[3]), MUL(a[1], b[2]));
+    c[3] = ADD(c[3], ADD(MUL(a[2], b[1]), MUL(a[3], b[0])));
+    c[4] = ADD(MUL(a[0], b[4]), MUL(a[1], b[3]));
+    c[4] = ADD(c[4], ADD(MUL(a[2], b[2]), MUL(a[3], b[1])));
+    c[4] = ADD(c[4], MUL(a[4], b[0]));
+    c[5] = ADD(MUL(a[0], b[5]), MUL(a[1], b[4]));
+    c[5] = ADD(c[5], ADD(MUL(a[2], b[3]), MUL(a[3], b[2])));
+    c[5] = ADD(c[5], ADD(MUL(a[4], b[1]), MUL(a[5], b[0])));
+    c[6] = ADD(MUL(a[0], b[6]), MUL(a[1], b[5]));
+    c[6] = ADD(c[6], ADD(MUL(a[2], b[4]), MUL(a[3], b[3])));
+    c[6] = ADD(c[6], ADD(MUL(a[4], b[2]), MUL(a[5], b[1])));
+    c[6] = ADD(c[6], MUL(a[6], b[0]));
+    c[7] = ADD(MUL(a[0], b[7]), MUL(a[1], b[6]));
+    c[7] = ADD(c[7], ADD(MUL(a[2], b[5]), MUL(a[3], b[4])));
+    c[7] = ADD(c[7], ADD(MUL(a[4], b[3]), MUL(a[5], b[2])));
+    c[7] = ADD(c[7], ADD(MUL(a[6], b[1]), MUL(a[7], b[0])));
+    c[8] = ADD(MUL(a[0], b[8]), MUL(a[1], b[7]));
+    c[8] = ADD(c[8], ADD(MUL(a[2], b[6]), MUL(a[3], b[5])));
+    c[8] = ADD(c[8], ADD(MUL(a[4], b[4]), MUL(a[5], b[3])));
+    c[8] = ADD(c[8], ADD(MUL(a[6], b[2]), MUL(a[7], b[1])));
+    c[8] = ADD(c[8], MUL(a[8], b[0]));
+    c[9] = ADD(MUL(a[0], b[9]), MUL(a[1], b[8]));
+    c[9] = ADD(c[9], ADD(MUL(a[2], b[7]), MUL(a[3], b[6])));
+    c[9] = ADD(c[9], ADD(MUL(a[4], b[5]), MUL(a[5], b[4])));
+    c[9] = ADD(c[9], ADD(MUL(a[6], b[3]), MUL(a[7], b[2])));
+    c[9] = ADD(c[9], ADD(MUL(a[8], b[1]), MUL(a[9], b[0])));
+    c[10] = ADD(MUL(a[1], b[9]), MUL(a[2], b[8]));
+    c[10] = ADD(c[10], ADD(MUL(a[3], b[7]), MUL(a[4], b[6])));
+    c[10] = ADD(c[10], ADD(MUL(a[5], b[5]), MUL(a[6], b[4])));
+    c[10] = ADD(c[10], ADD(MUL(a[7], b[3]), MUL(a[8], b[2])));
+    c[10] = ADD(c[10], MUL(a[9], b[1]));
+    c[11] = ADD(MUL(a[2], b[9]), MUL(a[3], b[8]));
+    c[11] = ADD(c[11], ADD(MUL(a[4], b[7]), MUL(a[5], b[6])));
+    c[11] = ADD(c[11], ADD(MUL(a[6], b[5]), MUL(a[7], b[4])));
+    c[11] = ADD(c[11], ADD(MUL(a[8], b[3]), MUL(a[9], b[2])));
+    c[12] = ADD(MUL(a[3], b[9]), MUL(a[4], b[8]));
+    c[12] = ADD(c[12], ADD(MUL(a[5], b[7]), MUL(a[6], b[6])));
+    c[12] = ADD(c[12], ADD(MUL(a[7], b[5]), MUL(a[8], b[4])));
+    c[12] = ADD(c[12], MUL(a[9], b[3]));
+    c[13] = ADD(MUL(a[4], b[9]), MUL(a[5], b[8]));
+    c[13] = ADD(c[13], ADD(MUL(a[6], b[7]), MUL(a[7], b[6])));
+    c[13] = ADD(c[13], ADD(MUL(a[8], b[5]), MUL(a[9], b[4])));
+    c[14] = ADD(MUL(a[5], b[9]), MUL(a[6], b[8]));
+    c[14] = ADD(c[14], ADD(MUL(a[7], b[7]), MUL(a[8], b[6])));
+    c[14] = ADD(c[14], MUL(a[9], b[5]));
+    c[15] = ADD(MUL(a[6], b[9]), MUL(a[7], b[8]));
+    c[15] = ADD(c[15], ADD(MUL(a[8], b[7]), MUL(a[9], b[6])));
+    c[16] = ADD(MUL(a[7], b[9]), MUL(a[8], b[8]));
+    c[16] = ADD(c[16], MUL(a[9], b[7]));
+    c[17] = ADD(MUL(a[8], b[9]), MUL(a[9], b[8]));
+    c[18] = MUL(a[9], b[9]);
+    c[19] = _mm256_setzero_si256();
+
+    MulReduce(r, c);
+
+  }
+
+  static inline void Sqr(F r, const F a) {
+
+    __m256i c[20];
+    __m256i a2[10];
+
+    for (int i = 0; i < 10; i++)
+      a2[i] = SHL(a[i], 1);
+    c[0] = MUL(a[0], a[0]);
+    c[1] = MUL(a2[0], a[1]);
+    c[2] = ADD(MUL(a[1], a[1]), MUL(a2[0], a[2]));
+    c[3] = ADD(MUL(a2[0], a[3]), MUL(a2[1], a[2]));
+    c[4] = ADD(MUL(a[2], a[2]), MUL(a2[0], a[4]));
+    c[4] = ADD(c[4], MUL(a2[1], a[3]));
+    c[5] = ADD(MUL(a2[0], a[5]), MUL(a2[1], a[4]));
+    c[5] = ADD(c[5], MUL(a2[2], a[3]));
+    c[6] = ADD(MUL(a[3], a[3]), MUL(a2[0], a[6]));
+    c[6] = ADD(c[6], ADD(MUL(a2[1], a[5]), MUL(a2[2], a[4])));
+    c[7] = ADD(MUL(a2[0], a[7]), MUL(a2[1], a[6]));
+    c[7] = ADD(c[7], ADD(MUL(a2[2], a[5]), MUL(a2[3], a[4])));
+    c[8] = ADD(MUL(a[4], a[4]), MUL(a2[0], a[8]));
+    c[8] = ADD(c[8], ADD(MUL(a2[1], a[7]), MUL(a2[2], a[6])));
+    c[8] = ADD(c[8], MUL(a2[3], a[5]));
+    c[9] = ADD(MUL(a2[0], a[9]), MUL(a2[1], a[8]));
+    c[9] = ADD(c[9], ADD(MUL(a2[2], a[7]), MUL(a2[3], a[6])));
+    c[9] = ADD(c[9], MUL(a2[4], a[5]));
+    c[10] = ADD(MUL(a[5], a[5]), MUL(a2[1], a[9]));
+    c[10] = ADD(c[10], ADD(MUL(a2[2], a[8]), MUL(a2[3], a[7])));
+    c[10] = ADD(c[10], MUL(a2[4], a[6]));
+    c[11] = ADD(MUL(a2[2], a[9]), MUL(a2[3], a[8]));
+    c[11] = ADD(c[11], ADD(MUL(a2[4], a[7]), MUL(a2[5], a[6])));
+    c[12] = ADD(MUL(a[6], a[6]), MUL(a2[3], a[9]));
+    c[12] = ADD(c[12], ADD(MUL(a2[4], a[8]), MUL(a2[5], a[7])));
+    c[13] = ADD(MUL(a2[4], a[9]), MUL(a2[5], a[8]));
+    c[13] = ADD(c[13], MUL(a2[6], a[7]));
+    c[14] = ADD(MUL(a[7], a[7]), MUL(a2[5], a[9]));
+    c[14] = ADD(c[14], MUL(a2[6], a[8]));
+    c[15] = ADD(MUL(a2[6], a[9]), MUL(a2[7], a[8]));
+    c[16] = ADD(MUL(a[8], a[8]), MUL(a2[7], a[9]));
+    c[17] = MUL(a2[8], a[9]);
+    c[18] = MUL(a[9], a[9]);
+    c[19] = _mm256_setzero_si256();
+
+    MulReduce(r, c);
+
+  }
+
+  // r = a + b
+  static inline void Add(F r, const F a, const F b) {
+
+    for (int i = 0; i < 10; i++)
+      r[i] = ADD(a[i], b[i]);
+    Norm(r);
+
+  }
+
+  // r = a - b
+  static inline void Sub(F r, const F a, const F b) {
+
+    for (int i = 0; i < 10; i++)
+      r[i] = SUB(ADD(a[i], _mm256_set1_epi64x(P32[i])), b[i]);
+    Norm(r);
+
+  }
+
+  // r = -a - b
+  static inline void NegSub(F r, const F a, const F b) {
+
+    for (int i = 0; i < 10; i++)
+      r[i] = SUB(SUB(_mm256_set1_epi64x(2 * P32[i]), a[i]), b[i]);
+    Norm(r);
+
+  }
+
+} // end namespace
+
+using namespace _intmod4;
+
+void ModMulK1x4(uint64_t *r[4], uint64_t *a[4], uint64_t *b[4]) {
+
+  F fa, fb, fr;
+
+  Load(fa, a[0], a[1], a[2], a[3]);
+  Load(fb, b[0], b[1], b[2], b[3]);
+  Mul(fr, fa, fb);
+  Reduce(fr);
+  Store(fr, r[0], r[1], r[2], r[3]);
+
+}
+
+void ModSquareK1x4(uint64_t *r[4], uint64_t *a[4]) {
+
+  F fa, fr;
+
+  Load(fa, a[0], a[1], a[2], a[3]);
+  Sqr(fr, fa);
+  Reduce(fr);
+  Store(fr, r[0], r[1], r[2], r[3]);
+
+}
+
+void AddGroup4(uint64_t *px, uint64_t *py, uint64_t *gx[4], uint64_t *gy[4], uint64_t *dx[4],
+               uint64_t *ppx[4], uint64_t *ppy[4], uint64_t *pnx[4], uint64_t *pny[4]) {
+
+  F fpx, fpy, fgx, fgy, d;
+  F dy, s, t, rx, ry;
+
+  Load(fpx, px, px, px, px);
+  Load(fpy, py, py, py, py);
+  Load(fgx, gx[0], gx[1], gx[2], gx[3]);
+  Load(fgy, gy[0], gy[1], gy[2], gy[3]);
+  Load(d, dx[0], dx[1], dx[2], dx[3]);
+
+  // P + G
+  Sub(dy, fgy, fpy);
+  Mul(s, dy, d);        // s = (p2.y-p1.y)*inverse(p2.x-p1.x)
+  Sqr(t, s);
+  Sub(rx, t, fpx);
+  Sub(rx, rx, fgx);     // rx = pow2(s) - p1.x - p2.x
+  Sub(t, fgx, rx);
+  Mul(ry, t, s);
+  Sub(ry, ry, fgy);     // ry = - p2.y - s*(ret.x-p2.x)
+  Reduce(rx);
+  Reduce(ry);
+  Store(rx, ppx[0], ppx[1], ppx[2], ppx[3]);
+  Store(ry, ppy[0], ppy[1], ppy[2], ppy[3]);
+
+  // P - G, if (x,y) = G then (x,-y) = -G
+  NegSub(dy, fgy, fpy);
+  Mul(s, dy, d);
+  Sqr(t, s);
+  Sub(rx, t, fpx);
+  Sub(rx, rx, fgx);
+  Sub(t, fgx, rx);
+  Mul(ry, t, s);
+  Add(ry, ry, fgy);
+  Reduce(rx);
+  Reduce(ry);
+  Store(rx, pnx[0], pnx[1], pnx[2], pnx[3]);
+  Store(ry, pny[0], pny[1], pny[2], pny[3]);
+
+}
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INTMOD8H
+#define INTMOD8H
+
+#include <stdint.h>
+
+// 8-way secp256k1 field arithmetic using AVX-512 IFMA (vpmadd52luq/vpmadd52huq),
+// lane j works on element j. Same conventions as IntMod4.h: elements are given as
+// pointers to 4 little endian 64 bits words (Int::bits64), inputs may be weakly
+// reduced (< 2^256), outputs are fully reduced (< P, bits64[4] not written).
+
+// r[j] = a[j] * b[j] (mod P), j = 0..7
+void ModMulK1x8(uint64_t *r[8], uint64_t *a[8], uint64_t *b[8]);
+
+// r[j] = a[j]^2 (mod P), j = 0..7
+void ModSquareK1x8(uint64_t *r[8], uint64_t *a[8]);
+
+// Group walk: (pp[j]) = p + g[j] and (pn[j]) = p - g[j] for j = 0..7 (affine),
+// dx[j] must hold 1/(g[j].x - p.x)
+void AddGroup8(uint64_t *px, uint64_t *py, uint64_t *gx[8], uint64_t *gy[8], uint64_t *dx[8],
+               uint64_t *ppx[8], uint64_t *ppy[8], uint64_t *pnx[8], uint64_t *pny[8]);
+
+#endif // INTMOD8H
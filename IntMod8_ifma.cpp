@@ -0,0 +1,302 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "IntMod8.h"
+#include <immintrin.h>
+
+// Field elements are split in 5 limbs of 52 bits, a limb holds 8 elements (one
+// per 64 bits lane). vpmadd52luq/vpmadd52huq accumulate the low/high 52 bits of
+// the 52x52 bits products, so limbs must be below 2^52 before a multiplication.
+// The high half of a product is folded using 2^260 = 0x1000003D10 (mod P).
+// Between operations limbs are below 2^52 and the top one below 2^49 (weakly
+// reduced, value < 2^257).
+
+namespace _intmod8
+{
+
+  typedef __m512i F[5];
+
+#define M52     _mm512_set1_epi64(0xFFFFFFFFFFFFFULL)
+#define M48     _mm512_set1_epi64(0xFFFFFFFFFFFFULL)
+#define ADD(a,b) _mm512_add_epi64(a, b)
+#define SUB(a,b) _mm512_sub_epi64(a, b)
+#define AND(a,b) _mm512_and_si512(a, b)
+#define OR(a,b)  _mm512_or_si512(a, b)
+#define SHR(a,n) _mm512_srli_epi64(a, n)
+#define SHL(a,n) _mm512_slli_epi64(a, n)
+#define LO(c,a,b) c = _mm512_madd52lo_epu64(c, a, b)
+#define HI(c,a,b) c = _mm512_madd52hi_epu64(c, a, b)
+
+  // Propagate the carry of limb k to limb k+1
+#define CARRY(r,k) r[(k) + 1] = ADD(r[(k) + 1], SHR(r[k], 52)); r[k] = AND(r[k], M52);
+
+  // 2^256 = K1 and 2^260 = K16 (mod P)
+#define K1  _mm512_set1_epi64(0x1000003D1ULL)
+#define K16 _mm512_set1_epi64(0x1000003D10ULL)
+
+  // 4*P and 8*P, limbs above the limbs of a weakly reduced element
+  static const uint64_t P4[5] = {
+    0x3FFFFBFFFFF0BCULL, 0x3FFFFFFFFFFFFCULL, 0x3FFFFFFFFFFFFCULL, 0x3FFFFFFFFFFFFCULL, 0x3FFFFFFFFFFFCULL
+  };
+
+  // 8 elements to limbs
+  static inline void Load(F r, uint64_t **a) {
+
+    __m512i w[4];
+    for (int i = 0; i < 4; i++)
+      w[i] = _mm512_set_epi64(a[7][i], a[6][i], a[5][i], a[4][i], a[3][i], a[2][i], a[1][i], a[0][i]);
+
+    r[0] = AND(w[0], M52);
+    r[1] = AND(OR(SHR(w[0], 52), SHL(w[1], 12)), M52);
+    r[2] = AND(OR(SHR(w[1], 40), SHL(w[2], 24)), M52);
+    r[3] = AND(OR(SHR(w[2], 28), SHL(w[3], 36)), M52);
+    r[4] = SHR(w[3], 16);
+
+  }
+
+  // Same element in the 8 lanes
+  static inline void Load1(F r, uint64_t *a) {
+
+    r[0] = _mm512_set1_epi64(a[0] & 0xFFFFFFFFFFFFFULL);
+    r[1] = _mm512_set1_epi64(((a[0] >> 52) | (a[1] << 12)) & 0xFFFFFFFFFFFFFULL);
+    r[2] = _mm512_set1_epi64(((a[1] >> 40) | (a[2] << 24)) & 0xFFFFFFFFFFFFFULL);
+    r[3] = _mm512_set1_epi64(((a[2] >> 28) | (a[3] << 36)) & 0xFFFFFFFFFFFFFULL);
+    r[4] = _mm512_set1_epi64(a[3] >> 16);
+
+  }
+
+  // Limbs (fully reduced) to 8 elements
+  static inline void Store(F r, uint64_t **a) {
+
+#ifdef WIN64
+    __declspec(align(64)) uint64_t w[4][8];
+#else
+    uint64_t w[4][8] __attribute__((aligned(64)));
+#endif
+
+    _mm512_store_si512(w[0], OR(r[0], SHL(r[1], 52)));
+    _mm512_store_si512(w[1], OR(SHR(r[1], 12), SHL(r[2], 40)));
+    _mm512_store_si512(w[2], OR(SHR(r[2], 24), SHL(r[3], 28)));
+    _mm512_store_si512(w[3], OR(SHR(r[3], 36), SHL(r[4], 16)));
+
+    for (int j = 0; j < 8; j++) {
+      a[j][0] = w[0][j];
+      a[j][1] = w[1][j];
+      a[j][2] = w[2][j];
+      a[j][3] = w[3][j];
+    }
+
+  }
+
+  // Weak reduction: limbs < 2^52, r[4] < 2^49 (input limbs < 2^60)
+  static inline void Norm(F r) {
+
+    CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3);
+    __m512i c = SHR(r[4], 48);
+    r[4] = AND(r[4], M48);
+    LO(r[0], c, K1);
+    CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3);
+
+  }
+
+  // Full reduction: 0 <= r < P
+  static inline void Reduce(F r) {
+
+    F t;
+
+    // r[4] <= 2^48, a last fold of the bit 256 gives r < 2^256
+    __m512i c = SHR(r[4], 48);
+    r[4] = AND(r[4], M48);
+    LO(r[0], c, K1);
+    CARRY(r, 0); CARRY(r, 1); CARRY(r, 2); CARRY(r, 3);
+
+    // r >= P <=> r + 2^32 + 977 >= 2^256
+    for (int i = 0; i < 5; i++)
+      t[i] = r[i];
+    t[0] = ADD(t[0], K1);
+    CARRY(t, 0); CARRY(t, 1); CARRY(t, 2); CARRY(t, 3);
+    __mmask8 ge = _mm512_test_epi64_mask(t[4], _mm512_set1_epi64(1ULL << 48));
+    t[4] = AND(t[4], M48);
+    for (int i = 0; i < 5; i++)
+      r[i] = _mm512_mask_mov_epi64(r[i], ge, t[i]);
+
+  }
+
+  // Fold the 10 columns of a product into r
+  static inline void MulReduce(F r, __m512i *c) {
+
+    __m512i r5 = _mm512_setzero_si512();
+
+    // c[9] < 2^52 as the inputs are < 2^257
+    CARRY(c, 0); CARRY(c, 1); CARRY(c, 2); CARRY(c, 3); CARRY(c, 4);
+    CARRY(c, 5); CARRY(c, 6); CARRY(c, 7); CARRY(c, 8);
+
+    // Columns 5..9 weigh 2^260 * 2^(52(k-5))
+    for (int i = 0; i < 5; i++)
+      r[i] = c[i];
+    LO(r[0], c[5], K16); HI(r[1], c[5], K16);
+    LO(r[1], c[6], K16); HI(r[2], c[6], K16);
+    LO(r[2], c[7], K16); HI(r[3], c[7], K16);
+    LO(r[3], c[8], K16); HI(r[4], c[8], K16);
+    LO(r[4], c[9], K16); HI(r5, c[9], K16);
+
+    // r5 < 2^38
+    LO(r[0], r5, K16); HI(r[1], r5, K16);
+
+    Norm(r);
+
+  }
+
+  static inline void Mul(F r, const F a, const F b) {
+
+    __m512i c[10];
+
+    for (int t = 0; t < 10; t++)
+      c[t] = _mm512_setzero_si512();
+    LO(c[0], a[0], b[0]); LO(c[1], a[0], b[1]); LO(c[2], a[0], b[2]); LO(c[3], a[0], b[3]); LO(c[4], a[0], b[4]);
+    HI(c[1], a[0], b[0]); HI(c[2], a[0], b[1]); HI(c[3], a[0], b[2]); HI(c[4], a[0], b[3]); HI(c[5], a[0], b[4]);
+    LO(c[1], a[1], b[0]); LO(c[2], a[1], b[1]); LO(c[3], a[1], b[2]); LO(c[4], a[1], b[3]); LO(c[5], a[1], b[4]);
+    HI(c[2], a[1], b[0]); HI(c[3], a[1], b[1]); HI(c[4], a[1], b[2]); HI(c[5], a[1], b[3]); HI(c[6], a[1], b[4]);
+    LO(c[2], a[2], b[0]); LO(c[3], a[2], b[1]); LO(c[4], a[2], b[2]); LO(c[5], a[2], b[3]); LO(c[6], a[2], b[4]);
+    HI(c[3], a[2], b[0]); HI(c[4], a[2], b[1]); HI(c[5], a[2], b[2]); HI(c[6], a[2], b[3]); HI(c[7], a[2], b[4]);
+    LO(c[3], a[3], b[0]); LO(c[4], a[3], b[1]); LO(c[5], a[3], b[2]); LO(c[6], a[3], b[3]); LO(c[7], a[3], b[4]);
+    HI(c[4], a[3], b[0]); HI(c[5], a[3], b[1]); HI(c[6], a[3], b[2]); HI(c[7], a[3], b[3]); HI(c[8], a[3], b[4]);
+    LO(c[4], a[4], b[0]); LO(c[5], a[4], b[1]); LO(c[6], a[4], b[2]); LO(c[7], a[4], b[3]); LO(c[8], a[4], b[4]);
+    HI(c[5], a[4], b[0]); HI(c[6], a[4], b[1]); HI(c[7], a[4], b[2]); HI(c[8], a[4], b[3]); HI(c[9], a[4], b[4]);
+
+    MulReduce(r, c);
+
+  }
+
+  static inline void Sqr(F r, const F a) {
+
+    __m512i c[10];
+
+    for (int t = 0; t < 10; t++)
+      c[t] = _mm512_setzero_si512();
+    LO(c[1], a[0], a[1]); LO(c[2], a[0], a[2]); LO(c[3], a[0], a[3]); LO(c[4], a[0], a[4]);
+    HI(c[2], a[0], a[1]); HI(c[3], a[0], a[2]); HI(c[4], a[0], a[3]); HI(c[5], a[0], a[4]);
+    LO(c[3], a[1], a[2]); LO(c[4], a[1], a[3]); LO(c[5], a[1], a[4]);
+    HI(c[4], a[1], a[2]); HI(c[5], a[1], a[3]); HI(c[6], a[1], a[4]);
+    LO(c[5], a[2], a[3]); LO(c[6], a[2], a[4]);
+    HI(c[6], a[2], a[3]); HI(c[7], a[2], a[4]);
+    LO(c[7], a[3], a[4]);
+    HI(c[8], a[3], a[4]);
+    for (int t = 1; t < 9; t++)
+      c[t] = SHL(c[t], 1);
+    LO(c[0], a[0], a[0]); LO(c[2], a[1], a[1]); LO(c[4], a[2], a[2]); LO(c[6], a[3], a[3]); LO(c[8], a[4], a[4]);
+    HI(c[1], a[0], a[0]); HI(c[3], a[1], a[1]); HI(c[5], a[2], a[2]); HI(c[7], a[3], a[3]); HI(c[9], a[4], a[4]);
+
+    MulReduce(r, c);
+
+  }
+
+  // r = a + b
+  static inline void Add(F r, const F a, const F b) {
+
+    for (int i = 0; i < 5; i++)
+      r[i] = ADD(a[i], b[i]);
+    Norm(r);
+
+  }
+
+  // r = a - b
+  static inline void Sub(F r, const F a, const F b) {
+
+    for (int i = 0; i < 5; i++)
+      r[i] = SUB(ADD(a[i], _mm512_set1_epi64(P4[i])), b[i]);
+    Norm(r);
+
+  }
+
+  // r = -a - b
+  static inline void NegSub(F r, const F a, const F b) {
+
+    for (int i = 0; i < 5; i++)
+      r[i] = SUB(SUB(_mm512_set1_epi64(2 * P4[i]), a[i]), b[i]);
+    Norm(r);
+
+  }
+
+} // end namespace
+
+using namespace _intmod8;
+
+void ModMulK1x8(uint64_t *r[8], uint64_t *a[8], uint64_t *b[8]) {
+
+  F fa, fb, fr;
+
+  Load(fa, a);
+  Load(fb, b);
+  Mul(fr, fa, fb);
+  Reduce(fr);
+  Store(fr, r);
+
+}
+
+void ModSquareK1x8(uint64_t *r[8], uint64_t *a[8]) {
+
+  F fa, fr;
+
+  Load(fa, a);
+  Sqr(fr, fa);
+  Reduce(fr);
+  Store(fr, r);
+
+}
+
+void AddGroup8(uint64_t *px, uint64_t *py, uint64_t *gx[8], uint64_t *gy[8], uint64_t *dx[8],
+               uint64_t *ppx[8], uint64_t *ppy[8], uint64_t *pnx[8], uint64_t *pny[8]) {
+
+  F fpx, fpy, fgx, fgy, d;
+  F dy, s, t, rx, ry;
+
+  Load1(fpx, px);
+  Load1(fpy, py);
+  Load(fgx, gx);
+  Load(fgy, gy);
+  Load(d, dx);
+
+  // P + G
+  Sub(dy, fgy, fpy);
+  Mul(s, dy, d);        // s = (p2.y-p1.y)*inverse(p2.x-p1.x)
+  Sqr(t, s);
+  Sub(rx, t, fpx);
+  Sub(rx, rx, fgx);     // rx = pow2(s) - p1.x - p2.x
+  Sub(t, fgx, rx);
+  Mul(ry, t, s);
+  Sub(ry, ry, fgy);     // ry = - p2.y - s*(ret.x-p2.x)
+  Reduce(rx);
+  Reduce(ry);
+  Store(rx, ppx);
+  Store(ry, ppy);
+
+  // P - G, if (x,y) = G then (x,-y) = -G
+  NegSub(dy, fgy, fpy);
+  Mul(s, dy, d);
+  Sqr(t, s);
+  Sub(rx, t, fpx);
+  Sub(rx, rx, fgx);
+  Sub(t, fgx, rx);
+  Mul(ry, t, s);
+  Add(ry, ry, fgy);
+  Reduce(rx);
+  Reduce(ry);
+  Store(rx, pnx);
+  Store(ry, pny);
+
+}
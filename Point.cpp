@@ -356,31 +356,7 @@ void Point::DoubleDirect()
 
 void Point::MulDirect(const Int& s)
 {
-	Point p(*this);
-	Point r;
-
-	int bits = s.GetBitLength();
-
-	Point p2 = p;
-	bool assigned = false;
-	for (int i = 0; i < bits; ++i)
-	{
-		if (s.GetBit(i) == 1)
-		{
-			if (!assigned)
-			{
-				assigned = true;
-				r = p2;
-			}
-			else
-			{
-				r.Add(p2);
-			}
-		}
-		p2.Double();
-	}
-
-	r.Reduce();
+	Point r = Secp256K1::MulGLV(*this, s);
 
 	x = r.x;
 	y = r.y;
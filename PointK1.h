@@ -0,0 +1,47 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POINTK1H
+#define POINTK1H
+
+#include "IntK1.h"
+#include "Point.h"
+
+// Compact affine point (64 bytes, one cache line), no z coordinate.
+// Set() expects a reduced point (z = 1), Get() returns one.
+
+class K1ALIGN(64) PointK1 {
+
+public:
+
+	void Set(const Point& p) {
+		x.Set(p.x);
+		y.Set(p.y);
+	}
+
+	void Get(Point& p) const {
+		x.Get(p.x);
+		y.Get(p.y);
+		p.z.SetInt32(1);
+	}
+
+	IntK1 x;
+	IntK1 y;
+
+};
+
+#endif // POINTK1H
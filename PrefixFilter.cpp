@@ -0,0 +1,207 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PrefixFilter.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+using namespace std;
+
+// Bloom filter: false positive rate bounds, maximum number of 32 bit keys
+#define BLOOM_MIN_RATE 1e-4
+#define BLOOM_MAX_RATE (1.0 / 32.0)
+#define BLOOM_MAX_KEY (1ULL << 24)
+// Extra bits per key compensating the blocking (keys of a block are not uniform)
+#define BLOOM_BLOCK_OVERHEAD 1.2
+
+PrefixFilter::PrefixFilter() {
+
+	type = FILTER_NONE;
+	width = 0;
+	shift = 0;
+	nbBlock = 0;
+	nbHash = 0;
+	rate = 1.0;
+	lookupRate = 1.0;
+	size = 0;
+	bits = NULL;
+	buff = NULL;
+
+}
+
+PrefixFilter::~PrefixFilter() {
+
+	free(buff);
+
+}
+
+// ----------------------------------------------------------------------------
+
+// Number of width bits prefixes covered by the ranges (overlaps counted twice)
+double PrefixFilter::GetKeyCount(const uint64_t* rangeMin, const uint64_t* rangeMax, uint64_t nbRange, int width) {
+
+	int s = 64 - width;
+	double n = 0.0;
+	for (uint64_t i = 0; i < nbRange; i++)
+		n += (double)((rangeMax[i] >> s) - (rangeMin[i] >> s)) + 1.0;
+	return n;
+
+}
+
+// Zeroed, cache line aligned
+void PrefixFilter::Alloc(uint64_t nbWord) {
+
+	size = nbWord * 8;
+	buff = malloc(size + 64);
+	if (buff == NULL) {
+		printf("PrefixFilter: Failed to allocate %.1f MB\n", (double)size / 1048576.0);
+		exit(1);
+	}
+	bits = (uint64_t*)(((uintptr_t)buff + 63) & ~(uintptr_t)63);
+	memset(bits, 0, size);
+
+}
+
+// ----------------------------------------------------------------------------
+
+void PrefixFilter::Build(const uint64_t* rangeMin, const uint64_t* rangeMax, uint64_t nbRange, double lookupRate, double nbItem) {
+
+	// Rate keeping the item checks per hash constant
+	double target = FILTER_ITEM_RATE / nbItem;
+	if (nbRange == 0 || lookupRate <= target)
+		return;
+
+	// Candidates: the smallest meeting the target, else the most selective bitmap
+	// if it halves the lookup rate at least
+	double bestSize = 0.0;
+	double bestRate = lookupRate / 2.0;
+	int bestWidth = 0;
+	bool found = false;
+
+	for (int w = 20; w <= 28; w += 4) {
+		double r = GetKeyCount(rangeMin, rangeMax, nbRange, w) / pow(2.0, w);
+		double s = pow(2.0, w) / 8.0;
+		if (r <= target) {
+			if (!found || s < bestSize) {
+				found = true;
+				bestSize = s;
+				bestRate = r;
+				bestWidth = w;
+			}
+		}
+		else if (!found && r < bestRate) {
+			bestRate = r;
+			bestWidth = w;
+		}
+	}
+
+	// The Bloom filter is probed after a 16 bit lookup hit only
+	double nbKey = GetKeyCount(rangeMin, rangeMax, nbRange, 32);
+	double p = target / lookupRate;
+	if (p < BLOOM_MIN_RATE) p = BLOOM_MIN_RATE;
+	if (p > BLOOM_MAX_RATE) p = BLOOM_MAX_RATE;
+	double bitPerKey = -log(p) / (log(2.0) * log(2.0));
+	uint64_t bloomBlock = (uint64_t)ceil(nbKey * bitPerKey * BLOOM_BLOCK_OVERHEAD / 512.0);
+	double bloomRate = lookupRate * p + nbKey / pow(2.0, 32);
+	bool useBloom = (nbKey <= (double)BLOOM_MAX_KEY) &&
+		(!found || (double)bloomBlock * 64.0 < bestSize) &&
+		(found || bloomRate < bestRate);
+
+	this->lookupRate = lookupRate;
+
+	if (useBloom) {
+
+		type = FILTER_BLOOM;
+		nbBlock = bloomBlock;
+		nbHash = (int)(bitPerKey * log(2.0) + 0.5);
+		if (nbHash < 1) nbHash = 1;
+		if (nbHash > 16) nbHash = 16;
+		rate = bloomRate;
+		Alloc(nbBlock * 8);
+
+		for (uint64_t i = 0; i < nbRange; i++) {
+			for (uint64_t k = rangeMin[i] >> 32; k <= (rangeMax[i] >> 32); k++) {
+				uint64_t h = Mix(k);
+				uint64_t* blk = bits + ((((h >> 32) * nbBlock) >> 32) << 3);
+				uint32_t h1 = (uint32_t)h;
+				uint32_t h2 = (uint32_t)(h >> 23) | 1;
+				for (int j = 0; j < nbHash; j++) {
+					uint32_t b = (h1 + j * h2) & 511;
+					blk[b >> 6] |= 1ULL << (b & 63);
+				}
+			}
+		}
+
+	}
+	else if (bestWidth > 0) {
+
+		type = FILTER_BITMAP;
+		width = bestWidth;
+		shift = 64 - width;
+		rate = bestRate;
+		Alloc((1ULL << width) / 64);
+
+		for (uint64_t i = 0; i < nbRange; i++) {
+			uint64_t kMin = rangeMin[i] >> shift;
+			uint64_t kMax = rangeMax[i] >> shift;
+			// Whole words inside the range at once
+			uint64_t k = kMin;
+			while (k <= kMax) {
+				if ((k & 63) == 0 && k + 63 <= kMax) {
+					bits[k >> 6] = 0xFFFFFFFFFFFFFFFFULL;
+					k += 64;
+				}
+				else {
+					bits[k >> 6] |= 1ULL << (k & 63);
+					k++;
+				}
+			}
+		}
+
+	}
+
+}
+
+// ----------------------------------------------------------------------------
+
+string PrefixFilter::GetInfo() const {
+
+	char tmp[256];
+	char sz[32];
+
+	if (size < 1048576)
+		sprintf(sz, "%.0f KB", (double)size / 1024.0);
+	else
+		sprintf(sz, "%.1f MB", (double)size / 1048576.0);
+
+	switch (type) {
+	case FILTER_BITMAP:
+		sprintf(tmp, "%d bit bitmap, %s, expected hit rate %.3f%%", width, sz, rate * 100.0 / lookupRate);
+		break;
+	case FILTER_BLOOM:
+		sprintf(tmp, "Bloom (%d hash), %s, expected hit rate %.3f%%", nbHash, sz, rate * 100.0 / lookupRate);
+		break;
+	default:
+		sprintf(tmp, "none");
+		break;
+	}
+
+	return string(tmp);
+
+}
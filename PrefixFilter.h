@@ -0,0 +1,102 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PREFIXFILTERH
+#define PREFIXFILTERH
+
+#include <stdint.h>
+#include <string>
+
+// Filter type
+#define FILTER_NONE 0
+#define FILTER_BITMAP 1   // 1 bit per 20, 24 or 28 bit hash160 prefix
+#define FILTER_BLOOM 2    // Blocked Bloom filter (one cache line) of the 32 bit hash160 prefixes
+
+// Item checks per hash the filter aims at, whatever the number of targets
+#define FILTER_ITEM_RATE (1.0 / 16.0)
+
+// Second stage of the CPU prefix lookup, for large target sets where most of the
+// 16 bit prefixes are used. Built once from the hash160 ranges of the targets, the
+// type and size are selected from the prefixes they cover (may be FILTER_NONE).
+// Check() may pass a hash160 that matches no range, never the opposite.
+class PrefixFilter {
+
+public:
+
+	PrefixFilter();
+	~PrefixFilter();
+
+	// rangeMin, rangeMax: first 8 bytes (big endian) of the inclusive bounds of the ranges
+	// lookupRate: fraction of the hash passing the 16 bit lookup
+	// nbItem: average number of items of a used 16 bit prefix
+	void Build(const uint64_t* rangeMin, const uint64_t* rangeMax, uint64_t nbRange, double lookupRate, double nbItem);
+
+	int GetType() const { return type; }
+	double GetRate() const { return rate; }   // Expected fraction of random hash160 passing
+	// GetInfo() reports the expected hit rate of the probes (16 bit lookup hits)
+	std::string GetInfo() const;
+
+	// h64: first 8 bytes of the hash160 (big endian)
+	inline bool Check(uint64_t h64) const {
+
+		if (type == FILTER_BITMAP) {
+			uint64_t k = h64 >> shift;
+			return (bits[k >> 6] >> (k & 63)) & 1;
+		}
+
+		uint64_t h = Mix(h64 >> 32);
+		const uint64_t* blk = bits + ((((h >> 32) * nbBlock) >> 32) << 3);
+		uint32_t h1 = (uint32_t)h;
+		uint32_t h2 = (uint32_t)(h >> 23) | 1;
+		for (int i = 0; i < nbHash; i++) {
+			uint32_t b = (h1 + i * h2) & 511;
+			if (((blk[b >> 6] >> (b & 63)) & 1) == 0)
+				return false;
+		}
+		return true;
+
+	}
+
+private:
+
+	static inline uint64_t Mix(uint64_t k) {
+		// MurmurHash3 finalizer
+		k ^= k >> 33;
+		k *= 0xFF51AFD7ED558CCDULL;
+		k ^= k >> 33;
+		k *= 0xC4CEB9FE1A85EC53ULL;
+		k ^= k >> 33;
+		return k;
+	}
+
+	static double GetKeyCount(const uint64_t* rangeMin, const uint64_t* rangeMax, uint64_t nbRange, int width);
+	void Alloc(uint64_t nbWord);
+
+	int type;
+	int width;          // Bitmap: prefix bits
+	int shift;          // Bitmap: 64 - width
+	uint64_t nbBlock;   // Bloom: 512 bit blocks
+	int nbHash;         // Bloom: bits per key
+	double rate;
+	double lookupRate;
+	uint64_t size;      // Bytes
+	uint64_t* bits;
+	void* buff;
+
+};
+
+#endif // PREFIXFILTERH
@@ -20,7 +20,22 @@
 #include "hash/ripemd160.h"
 #include "Base58.h"
 #include "Bech32.h"
+#include "Timer.h"
+#include "IntMod4.h"
+#include "IntMod8.h"
+#include "IntGroup.h"
+#ifndef GTABLE_GENERATOR
+#include "GTable.h"
+#if GTABLE_GEN_WINDOW != GTABLE_WINDOW
+#error "GTable.h was generated for another GTABLE_WINDOW, rebuild it (make GTable.h)"
+#endif
+#endif
 #include <string.h>
+#ifdef WIN64
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
 
 // Prime for the finite field
 Int Secp256K1::prime("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
@@ -37,7 +52,9 @@ Int Secp256K1::lambda2("AC9C52B33FA3CF1F5AD9E3FD77ED9BA4A880B9FC8EC739C2E0CFC810
 Point Secp256K1::G("0479BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8");
 // Half of Generator point
 Point Secp256K1::halfG("0400000000000000000000003B78CE563F89A0ED9414F5AA28AD0D96D6795F9C63C0C686408D517DFD67C2367651380D00D126E4229631FD03F8FF35EEF1A61E3C");
-Point Secp256K1::GTable[256 * 32];
+PointK1* Secp256K1::GTable = NULL;
+int Secp256K1::gtableWindow = 0;
+int Secp256K1::gtableNbWindow = 0;
 
 void Secp256K1::Init()
 {
@@ -46,19 +63,185 @@ void Secp256K1::Init()
 	Int::SetupField(prime);
 	Int::InitK1(order);
 
-	// Compute Generator table
-	Point N(G);
-	for (int i = 0; i < 32; i++)
+	// Generator table, baked in GTable.h (generated at build time by CPUGenerate)
+#ifdef GTABLE_GENERATOR
+	InitGTable(GTABLE_WINDOW);
+#else
+	GTable = (PointK1*)CPU_GTable;
+	gtableWindow = GTABLE_WINDOW;
+	gtableNbWindow = (256 + GTABLE_WINDOW - 1) / GTABLE_WINDOW;
+#endif
+}
+
+// Write the CPU tables (CPUGroup.h: Gn, _2Gn and GTable.h: GTable for the
+// current window) that are compiled into the binary, see CPUGenerate.cpp.
+void Secp256K1::GenerateCode(int grpSize)
+{
+	// Gn[i] = (i+1)*G
+	Point* Gn = new Point[grpSize / 2];
+	Point g = G;
+	Gn[0] = g;
+	g = DoubleDirect(g);
+	Gn[1] = g;
+	for (int i = 2; i < grpSize / 2; i++)
 	{
-		GTable[i * 256] = N;
-		N = DoubleDirect(N);
-		for (int j = 1; j < 255; j++)
+		g = AddDirect(g, G);
+		Gn[i] = g;
+	}
+	// _2Gn = grpSize*G
+	Point _2Gn = DoubleDirect(Gn[grpSize / 2 - 1]);
+
+	FILE* f = fopen("CPUGroup.h", "w");
+	if (f == NULL)
+	{
+		printf("GenerateCode: Cannot open CPUGroup.h for writing\n");
+		exit(-1);
+	}
+	fprintf(f, "// File generated by Secp256K1::GenerateCode()\n");
+	fprintf(f, "// CPU group definitions (PointK1 layout: x[4],y[4])\n");
+	fprintf(f, "#define CPUGROUP_GRP_SIZE %d\n\n", grpSize);
+	fprintf(f, "// _2Gn = CPUGROUP_GRP_SIZE*G\n");
+	fprintf(f, "K1ALIGN(64) static const uint64_t CPU_2Gn[2][4] = { %s,%s };\n\n",
+		_2Gn.x.GetC64Str(4).c_str(), _2Gn.y.GetC64Str(4).c_str());
+	fprintf(f, "// Generator table (Contains G,2G,3G,...,(CPUGROUP_GRP_SIZE/2)G)\n");
+	fprintf(f, "K1ALIGN(64) static const uint64_t CPU_Gn[][2][4] = {\n");
+	for (int i = 0; i < grpSize / 2; i++)
+		fprintf(f, "  { %s,%s },\n", Gn[i].x.GetC64Str(4).c_str(), Gn[i].y.GetC64Str(4).c_str());
+	fprintf(f, "};\n");
+	fclose(f);
+	delete[] Gn;
+
+	f = fopen("GTable.h", "w");
+	if (f == NULL)
+	{
+		printf("GenerateCode: Cannot open GTable.h for writing\n");
+		exit(-1);
+	}
+	Point p;
+	int nb = gtableNbWindow << gtableWindow;
+	fprintf(f, "// File generated by Secp256K1::GenerateCode()\n");
+	fprintf(f, "// Generator table (PointK1 layout: x[4],y[4]), see Secp256K1::InitGTable()\n");
+	fprintf(f, "#define GTABLE_GEN_WINDOW %d\n\n", gtableWindow);
+	fprintf(f, "K1ALIGN(64) static const uint64_t CPU_GTable[][2][4] = {\n");
+	for (int i = 0; i < nb; i++)
+	{
+		GTable[i].Get(p);
+		fprintf(f, "  { %s,%s },\n", p.x.GetC64Str(4).c_str(), p.y.GetC64Str(4).c_str());
+	}
+	fprintf(f, "};\n");
+	fclose(f);
+}
+
+// Window i of key (gtableWindow bits starting at bit gtableWindow*i)
+uint32_t Secp256K1::GetWindow(const Int& key, int i)
+{
+	int pos = gtableWindow * i;
+	int w = pos >> 6;
+	int s = pos & 63;
+	uint64_t v = key.bits64[w] >> s;
+	if (s + gtableWindow > 64 && w < 3)
+		v |= key.bits64[w + 1] << (64 - s);
+	return (uint32_t)(v & ((1ULL << gtableWindow) - 1));
+}
+
+// Generator table: window i holds (j+1).B(i), j = 0..2^window-1, B(i) = 2^(window*i).G.
+// The last entry of a window is B(i+1), kept for the check function.
+// Entries [m+1,2m] of all windows are computed in one step from entries [1,m]
+// and m.B(i) (affine additions, doubling for 2m), with one batch inversion per step.
+void Secp256K1::InitGTable(int window)
+{
+	int size = 1 << window;
+	int nbWindow = (256 + window - 1) / window;
+	PointK1* table = new PointK1[nbWindow * size];
+
+	Point B(G);
+	for (int i = 0; i < nbWindow; i++)
+	{
+		table[i * size].Set(B);
+		for (int j = 0; j < window; j++)
+			B = DoubleDirect(B);
+	}
+
+	IntK1* dx = new IntK1[nbWindow * size / 2];
+	Point P;
+	Point Q;
+	Point R;
+	Int inv;
+	Int _s;
+	Int _p;
+	Int a;
+
+	for (int m = 1; m < size; m *= 2)
+	{
+		int n = 0;
+		for (int i = 0; i < nbWindow; i++)
 		{
-			GTable[i * 256 + j] = N;
-			N = AddDirect(N, GTable[i * 256]);
+			PointK1* t = table + i * size;
+			t[m - 1].Get(Q);
+			for (int j = 1; j <= m; j++)
+			{
+				if (j == m)
+				{
+					a.ModAdd(Q.y, Q.y);
+				}
+				else
+				{
+					t[j - 1].Get(P);
+					a.ModSub(Q.x, P.x);
+				}
+				dx[n++].Set(a);
+			}
+		}
+
+		IntGroup grp(n);
+		grp.Set(dx);
+		grp.ModInv();
+
+		n = 0;
+		for (int i = 0; i < nbWindow; i++)
+		{
+			PointK1* t = table + i * size;
+			t[m - 1].Get(Q);
+			for (int j = 1; j <= m; j++)
+			{
+				dx[n++].Get(inv);
+				t[j - 1].Get(P);
+				if (j == m)
+				{
+					_s.ModMulK1(P.x, P.x);
+					_p.ModAdd(_s, _s);
+					_p.ModAdd(_s);
+					_s.ModMulK1(_p, inv);     // s = (3*pow2(p.x))*inverse(2*p.y);
+				}
+				else
+				{
+					a.ModSub(Q.y, P.y);
+					_s.ModMulK1(a, inv);      // s = (q.y-p.y)*inverse(q.x-p.x);
+				}
+
+				_p.ModSquareK1(_s);
+				R.x.ModSub(_p, P.x);
+				R.x.ModSub(Q.x);              // rx = pow2(s) - p.x - q.x;
+
+				a.ModSub(P.x, R.x);
+				a.ModMulK1(_s);
+				R.y.ModSub(a, P.y);           // ry = s*(p.x-rx) - p.y;
+
+				if (R.x.IsGreaterOrEqual(prime)) R.x.Sub(prime);
+				if (R.y.IsGreaterOrEqual(prime)) R.y.Sub(prime);
+				t[m + j - 1].Set(R);
+			}
 		}
-		GTable[i * 256 + 255] = N; // Dummy point for check function
 	}
+
+	delete[] dx;
+#ifndef GTABLE_GENERATOR
+	if (GTable != (PointK1*)CPU_GTable)
+#endif
+		delete[] GTable;
+	GTable = table;
+	gtableWindow = window;
+	gtableNbWindow = nbWindow;
 }
 
 void Secp256K1::PrintResult(bool ok)
@@ -129,16 +312,93 @@ void Secp256K1::Check()
 	PrintResult(CheckCalcPubKeyEven());
 	printf("Check Calc PubKey (odd) :");
 	PrintResult(CheckCalcPubKeyOdd());
+	printf("Check Mul (GLV) :");
+	if (CheckMulGLV())
+	{
+		printf("OK\n");
+		BenchMulGLV();
+	}
+	else
+	{
+		printf("Failed !\n");
+	}
+
+	printf("Check Calc PubKey (batch) :");
+	if (CheckCalcPubKeyBatch())
+	{
+		printf("OK\n");
+		BenchCalcPubKeyBatch();
+	}
+	else
+	{
+		printf("Failed !\n");
+	}
+
+	for (int b = HASH_SCALAR; b < HASH_NB_BACKEND; b++)
+	{
+		printf("Check hash160 (%s) :", GetHashBackendName(b));
+		if (!IsHashBackendSupported(b))
+		{
+			printf("Not supported by this CPU\n");
+		}
+		else if (CheckHash160(b))
+		{
+			printf("OK\n");
+			printf("  P2PKH/BECH32 (compressed)   : ");
+			BenchHash160(b, P2PKH, true);
+			printf("  P2PKH/BECH32 (uncompressed) : ");
+			BenchHash160(b, P2PKH, false);
+			printf("  P2SH (compressed)           : ");
+			BenchHash160(b, P2SH, true);
+		}
+		else
+		{
+			printf("Failed !\n");
+		}
+	}
+
+	printf("Check hash160 (batch) :");
+	PrintResult(CheckHash160Batch());
+
+	printf("Check sha256 (sha-ni) :");
+	if (!sha256_shani_enabled())
+	{
+		printf("Not supported by this CPU\n");
+	}
+	else
+	{
+		PrintResult(CheckSha256());
+	}
+	BenchSha256();
+
+	for (int b = FIELD_SCALAR; b < FIELD_NB_BACKEND; b++)
+	{
+		printf("Check field (%s %d-way) :", GetFieldBackendName(b), GetFieldBackendWidth(b));
+		if (!IsFieldBackendSupported(b))
+		{
+			printf("Not supported by this CPU\n");
+		}
+		else
+		{
+			PrintResult(CheckField(b));
+			BenchField(b);
+		}
+	}
 }
 
 bool Secp256K1::CheckGTable()
 {
 	int i = 0;
-	while (i < 256 * 32 && EC(GTable[i]))
+	Point p;
+	int nb = gtableNbWindow << gtableWindow;
+	while (i < nb)
 	{
+		GTable[i].Get(p);
+		if (!EC(p))
+			break;
 		i++;
 	}
-	return i == 256 * 32;
+	return i == nb;
 }
 
 bool Secp256K1::CheckDouble()
@@ -216,31 +476,640 @@ bool Secp256K1::CheckCalcPubKeyOdd()
 	return EC(pub);
 }
 
+bool Secp256K1::CheckMulGLV()
+{
+	Point p;
+	Point q;
+	Point r;
+	Int k;
+	Int s;
+	bool ok = true;
+
+	for (int i = 0; i < 256 && ok; i++)
+	{
+		k.Rand(256);
+		p = ComputePublicKey(k);
+		switch (i)
+		{
+		case 0: s.SetInt32(1); break;
+		case 1: s.SetInt32(2); break;
+		case 2: s.SetInt32(15); break;
+		case 3: s.Set(order); s.Sub((uint64_t)1); break;
+		case 4: s.Set(lambda1); break;
+		case 5: s.Set(lambda2); break;
+		case 6: s.Set(halfOrder); break;
+		default: s.Rand(256); break;
+		}
+		q = MulDirect(p, s);
+		r = MulGLV(p, s);
+		if (q.x.IsGreaterOrEqual(prime)) q.x.Sub(prime);
+		if (q.y.IsGreaterOrEqual(prime)) q.y.Sub(prime);
+		if (r.x.IsGreaterOrEqual(prime)) r.x.Sub(prime);
+		if (r.y.IsGreaterOrEqual(prime)) r.y.Sub(prime);
+		ok = q.x.IsEqual(r.x) && q.y.IsEqual(r.y);
+		if (!ok)
+			printf("MulGLV wrong for %s\n", s.GetBase16().c_str());
+	}
+
+	return ok;
+}
+
+void Secp256K1::BenchMulGLV()
+{
+	const int n = 2048;
+	Point* p = new Point[n];
+	Int* s = new Int[n];
+	Point r;
+
+	for (int i = 0; i < n; i++)
+	{
+		s[i].Rand(256);
+		p[i] = ComputePublicKey(s[i]);
+		s[i].Rand(256);
+	}
+
+	double t0 = Timer::get_tick();
+	for (int i = 0; i < n; i++)
+		r = MulDirect(p[i], s[i]);
+	double t1 = Timer::get_tick();
+	printf("  MulDirect : ");
+	Timer::printResult((char*)"Mul", n, t0, t1);
+
+	t0 = Timer::get_tick();
+	for (int i = 0; i < n; i++)
+		r = MulGLV(p[i], s[i]);
+	t1 = Timer::get_tick();
+	printf("  MulGLV    : ");
+	Timer::printResult((char*)"Mul", n, t0, t1);
+
+	delete[] s;
+	delete[] p;
+}
+
+bool Secp256K1::CheckCalcPubKeyBatch()
+{
+	const int n = 4096;
+	Int* keys = new Int[n];
+	Point* p = new Point[n];
+	Point q;
+	Point offset;
+	bool ok = true;
+
+	// Random keys and some keys with degenerate windows
+	for (int i = 0; i < n; i++)
+		keys[i].Rand(256);
+	keys[0].SetInt32(1);
+	keys[1].SetInt32(255);
+	keys[2].SetInt32(256);
+	keys[3].Set(order);
+	keys[3].Sub((uint64_t)1);
+	Int k;
+	k.SetInt32(0x1234);
+	offset = ComputePublicKey(k);
+	keys[4].Set(order);
+	keys[4].Sub(k);
+	keys[5].SetInt32(0);
+
+	for (int pass = 0; pass < 2 && ok; pass++)
+	{
+		const Point* off = pass ? &offset : NULL;
+		ComputePublicKeyBatch(keys, p, n, off, 4);
+		for (int i = 0; i < n && ok; i++)
+		{
+			if ((pass && i == 4) || (!pass && i == 5))
+			{
+				// Point at infinity
+				ok = p[i].isZero();
+				if (!ok)
+					printf("Batch pubkey #%d wrong: %s\n", i, keys[i].GetBase16().c_str());
+				continue;
+			}
+			if (i == 5)
+				q = *off;  // Null key
+			else if (off)
+				q = AddDirect(ComputePublicKey(keys[i]), *off);
+			else
+				q = ComputePublicKey(keys[i]);
+			if (q.x.IsGreaterOrEqual(prime)) q.x.Sub(prime);
+			if (q.y.IsGreaterOrEqual(prime)) q.y.Sub(prime);
+			if (p[i].x.IsGreaterOrEqual(prime)) p[i].x.Sub(prime);
+			if (p[i].y.IsGreaterOrEqual(prime)) p[i].y.Sub(prime);
+			ok = q.x.IsEqual(p[i].x) && q.y.IsEqual(p[i].y) && p[i].z.IsOne();
+			if (!ok)
+				printf("Batch pubkey #%d wrong: %s\n", i, keys[i].GetBase16().c_str());
+		}
+	}
+
+	delete[] p;
+	delete[] keys;
+	return ok;
+}
+
+void Secp256K1::BenchCalcPubKeyBatch()
+{
+	const int n = 16384;
+	Int* keys = new Int[n];
+	Point* p = new Point[n];
+
+	for (int i = 0; i < n; i++)
+		keys[i].Rand(256);
+
+	double t0 = Timer::get_tick();
+	for (int i = 0; i < n; i++)
+		p[i] = ComputePublicKey(keys[i]);
+	double t1 = Timer::get_tick();
+	printf("  ComputePublicKey      : ");
+	Timer::printResult((char*)"PubKey", n, t0, t1);
+
+	t0 = Timer::get_tick();
+	ComputePublicKeyBatch(keys, p, n);
+	t1 = Timer::get_tick();
+	printf("  ComputePublicKeyBatch : ");
+	Timer::printResult((char*)"PubKey", n, t0, t1);
+
+	int nbThread = Timer::getCoreNumber();
+	t0 = Timer::get_tick();
+	ComputePublicKeyBatch(keys, p, n, NULL, nbThread);
+	t1 = Timer::get_tick();
+	printf("  ComputePublicKeyBatch (%d threads) : ", nbThread);
+	Timer::printResult((char*)"PubKey", n, t0, t1);
+
+	delete[] p;
+	delete[] keys;
+}
+
+// Compute 16 hash160 using the specified backend
+static void GetHash160ByBackend(int backend, int type, bool compressed, const Point* p, uint8_t h[16][20])
+{
+	switch (backend)
+	{
+		case HASH_AVX512:
+			Secp256K1::GetHash160x16(type, compressed, p, h);
+			break;
+
+		case HASH_AVX2:
+			for (int i = 0; i < 16; i += 8)
+				Secp256K1::GetHash160(type, compressed, p[i], p[i + 1], p[i + 2], p[i + 3], p[i + 4], p[i + 5], p[i + 6], p[i + 7],
+					h[i], h[i + 1], h[i + 2], h[i + 3], h[i + 4], h[i + 5], h[i + 6], h[i + 7]);
+			break;
+
+		case HASH_SSE:
+			for (int i = 0; i < 16; i += 4)
+				Secp256K1::GetHash160(type, compressed, p[i], p[i + 1], p[i + 2], p[i + 3], h[i], h[i + 1], h[i + 2], h[i + 3]);
+			break;
+
+		default:
+			for (int i = 0; i < 16; i++)
+				Secp256K1::GetHash160(type, compressed, p[i], h[i]);
+			break;
+	}
+}
+
+bool Secp256K1::CheckHash160(int backend)
+{
+	Point p[16];
+	uint8_t h[16][20];
+	uint8_t ch[20];
+
+	for (int r = 0; r < 4; r++)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			Int k;
+			k.Rand(256);
+			p[i] = ComputePublicKey(k);
+		}
+
+		for (unsigned int type = P2PKH; type <= BECH32; type++)
+		{
+			for (int c = 0; c < 2; c++)
+			{
+				GetHash160ByBackend(backend, type, c == 0, p, h);
+				for (int i = 0; i < 16; i++)
+				{
+					GetHash160(type, c == 0, p[i], ch);
+					if (memcmp(h[i], ch, 20) != 0)
+						return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Secp256K1::CheckHash160Batch()
+{
+	// 37 points: full AVX-512, AVX2 and SSE groups plus a scalar tail
+	const int n = 37;
+	Point p[n];
+	uint8_t h[n][20];
+	uint8_t ch[20];
+
+	Int k;
+	k.Rand(256);
+	p[0] = ComputePublicKey(k);
+	for (int i = 1; i < n; i++)
+		p[i] = NextKey(p[i - 1]);
+
+	for (unsigned int type = P2PKH; type <= BECH32; type++)
+	{
+		for (int c = 0; c < 2; c++)
+		{
+			GetHash160Batch(type, c == 0, p, n, h);
+			for (int i = 0; i < n; i++)
+			{
+				GetHash160(type, c == 0, p[i], ch);
+				if (memcmp(h[i], ch, 20) != 0)
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void Secp256K1::BenchHash160(int backend, int type, bool compressed)
+{
+	Point p[16];
+	uint8_t h[16][20];
+	const int nbTry = 4096;
+
+	Int k;
+	k.Rand(256);
+	p[0] = ComputePublicKey(k);
+	for (int i = 1; i < 16; i++)
+		p[i] = NextKey(p[i - 1]);
+
+	// SIMD backends are timed on the lane-transposed output used by the search
+	uint32_t ht[5 * 16];
+	int n = GetHashBackendWidth(backend);
+
+	double t0 = Timer::get_tick();
+	for (int i = 0; i < nbTry; i++)
+	{
+		if (backend == HASH_SCALAR)
+			GetHash160ByBackend(backend, type, compressed, p, h);
+		else
+			for (int j = 0; j < 16; j += n)
+				GetHash160T(backend, type, compressed, p + j, ht);
+	}
+	double t1 = Timer::get_tick();
+
+	Timer::printResult((char*)"Hash160", 16 * nbTry, t0, t1);
+}
+
+// CPU feature detection for the hash backends
+
+#ifdef WIN64
+#define XGETBV(i) _xgetbv(i)
+#else
+static uint64_t inline XGETBV(uint32_t i)
+{
+	uint32_t h;
+	uint32_t l;
+	__asm__("xgetbv;" :"=d"(h), "=a"(l) : "c"(i));
+	return (uint64_t)h << 32 | (uint64_t)l;
+}
+#endif
+
+bool Secp256K1::IsHashBackendSupported(int backend)
+{
+	int cpuiddata[4];
+
+	switch (backend)
+	{
+		case HASH_SCALAR:
+		case HASH_SSE:
+			return true;
+
+		case HASH_AVX2:
+		{
+			__cpuid(cpuiddata, 0x00000000);
+			if (cpuiddata[0] < 7)
+				return false;
+
+			// AVX and OS support for the YMM state (OSXSAVE + XCR0)
+			__cpuid(cpuiddata, 0x00000001);
+			if (((cpuiddata[2] >> 27) & 0x1) == 0 || ((cpuiddata[2] >> 28) & 0x1) == 0)
+				return false;
+			if ((XGETBV(0) & 0x6) != 0x6)
+				return false;
+
+			__cpuidex(cpuiddata, 7, 0);
+			return ((cpuiddata[1] >> 5) & 0x1) == 1;
+		}
+
+		case HASH_AVX512:
+		{
+			__cpuid(cpuiddata, 0x00000000);
+			if (cpuiddata[0] < 7)
+				return false;
+
+			// OS support for the opmask and ZMM states (OSXSAVE + XCR0)
+			__cpuid(cpuiddata, 0x00000001);
+			if (((cpuiddata[2] >> 27) & 0x1) == 0)
+				return false;
+			if ((XGETBV(0) & 0xE6) != 0xE6)
+				return false;
+
+			// AVX512F
+			__cpuidex(cpuiddata, 7, 0);
+			return ((cpuiddata[1] >> 16) & 0x1) == 1;
+		}
+	}
+
+	return false;
+}
+
+int Secp256K1::GetHashBackend()
+{
+	int backend = HASH_NB_BACKEND - 1;
+	while (backend > HASH_SCALAR && !IsHashBackendSupported(backend))
+		backend--;
+	return backend;
+}
+
+const char* Secp256K1::GetHashBackendName(int backend)
+{
+	switch (backend)
+	{
+		case HASH_SCALAR:
+			return "scalar";
+		case HASH_SSE:
+			return "sse";
+		case HASH_AVX2:
+			return "avx2";
+		case HASH_AVX512:
+			return "avx512";
+	}
+	return "unknown";
+}
+
+int Secp256K1::GetHashBackendWidth(int backend)
+{
+	switch (backend)
+	{
+		case HASH_SSE:
+			return 4;
+		case HASH_AVX2:
+			return 8;
+		case HASH_AVX512:
+			return 16;
+	}
+	return 1;
+}
+
+bool Secp256K1::IsFieldBackendSupported(int backend)
+{
+	int cpuiddata[4];
+
+	switch (backend)
+	{
+		case FIELD_SCALAR:
+			return true;
+
+		case FIELD_AVX2:
+			return IsHashBackendSupported(HASH_AVX2);
+
+		case FIELD_IFMA:
+			if (!IsHashBackendSupported(HASH_AVX512))
+				return false;
+			// AVX512IFMA
+			__cpuidex(cpuiddata, 7, 0);
+			return ((cpuiddata[1] >> 21) & 0x1) == 1;
+	}
+	return false;
+}
+
+int Secp256K1::GetFieldBackend()
+{
+	// The 4-way AVX2 engine (26 bits limbs) does not beat the 64 bits scalar
+	// ModMulK1 on the CPUs we benchmarked (see -check), it is kept opt-in
+	return IsFieldBackendSupported(FIELD_IFMA) ? FIELD_IFMA : FIELD_SCALAR;
+}
+
+const char* Secp256K1::GetFieldBackendName(int backend)
+{
+	switch (backend)
+	{
+		case FIELD_SCALAR:
+			return "scalar";
+		case FIELD_AVX2:
+			return "avx2";
+		case FIELD_IFMA:
+			return "ifma";
+	}
+	return "unknown";
+}
+
+int Secp256K1::GetFieldBackendWidth(int backend)
+{
+	switch (backend)
+	{
+		case FIELD_AVX2:
+			return 4;
+		case FIELD_IFMA:
+			return 8;
+	}
+	return 1;
+}
+
+// Scalar group walk step with lazy reduction: intermediates stay in [0,2^256)
+// (Int::ModAddK1/ModSubK1), results are normalized before being stored for hashing.
+static void AddGroupK1(const Point& p, const PointK1& g, const IntK1& dx, PointK1& pp, PointK1& pn)
+{
+	Int gx, gy, d;
+	Int dy, _s, _p;
+	Int rx, ry;
+
+	g.x.Get(gx);
+	g.y.Get(gy);
+	dx.Get(d);
+
+	// P + G: s = (g.y-p.y)/(g.x-p.x), rx = s^2 - p.x - g.x, ry = s*(g.x-rx) - g.y
+	dy.ModSubK1(gy, p.y);
+	_s.ModMulK1(dy, d);
+	_p.ModSquareK1(_s);
+	rx.ModSubK1(_p, p.x);
+	rx.ModSubK1(gx);
+	ry.ModSubK1(gx, rx);
+	ry.ModMulK1(_s);
+	ry.ModSubK1(gy);
+	rx.ModNormK1();
+	ry.ModNormK1();
+	pp.x.Set(rx);
+	pp.y.Set(ry);
+
+	// P - G = P + (g.x,-g.y): with -s = (g.y+p.y)/(g.x-p.x), ry = -s*(rx-g.x) + g.y
+	dy.ModAddK1(gy, p.y);
+	_s.ModMulK1(dy, d);
+	_p.ModSquareK1(_s);
+	rx.ModSubK1(_p, p.x);
+	rx.ModSubK1(gx);
+	ry.ModSubK1(rx, gx);
+	ry.ModMulK1(_s);
+	ry.ModAddK1(gy);
+	rx.ModNormK1();
+	ry.ModNormK1();
+	pn.x.Set(rx);
+	pn.y.Set(ry);
+}
+
+// AddGroupK1 on N independent streams, each step is issued for all the streams
+// before the next one: the dependency chains of the streams overlap.
+template<int N>
+static void AddGroupK1N(const Point* p, const PointK1& g, const IntK1* const* dx, PointK1* const* pp, PointK1* const* pn)
+{
+	Int gx, gy;
+	Int d[N];
+	Int dy[N], _s[N], _p[N];
+	Int rx[N], ry[N];
+	int s;
+
+	g.x.Get(gx);
+	g.y.Get(gy);
+	for (s = 0; s < N; s++)
+		dx[s]->Get(d[s]);
+
+	// P + G
+	for (s = 0; s < N; s++)
+		dy[s].ModSubK1(gy, p[s].y);
+	for (s = 0; s < N; s++)
+		_s[s].ModMulK1(dy[s], d[s]);
+	for (s = 0; s < N; s++)
+		_p[s].ModSquareK1(_s[s]);
+	for (s = 0; s < N; s++)
+	{
+		rx[s].ModSubK1(_p[s], p[s].x);
+		rx[s].ModSubK1(gx);
+		ry[s].ModSubK1(gx, rx[s]);
+	}
+	for (s = 0; s < N; s++)
+		ry[s].ModMulK1(_s[s]);
+	for (s = 0; s < N; s++)
+	{
+		ry[s].ModSubK1(gy);
+		rx[s].ModNormK1();
+		ry[s].ModNormK1();
+		pp[s]->x.Set(rx[s]);
+		pp[s]->y.Set(ry[s]);
+	}
+
+	// P - G
+	for (s = 0; s < N; s++)
+		dy[s].ModAddK1(gy, p[s].y);
+	for (s = 0; s < N; s++)
+		_s[s].ModMulK1(dy[s], d[s]);
+	for (s = 0; s < N; s++)
+		_p[s].ModSquareK1(_s[s]);
+	for (s = 0; s < N; s++)
+	{
+		rx[s].ModSubK1(_p[s], p[s].x);
+		rx[s].ModSubK1(gx);
+		ry[s].ModSubK1(rx[s], gx);
+	}
+	for (s = 0; s < N; s++)
+		ry[s].ModMulK1(_s[s]);
+	for (s = 0; s < N; s++)
+	{
+		ry[s].ModAddK1(gy);
+		rx[s].ModNormK1();
+		ry[s].ModNormK1();
+		pn[s]->x.Set(rx[s]);
+		pn[s]->y.Set(ry[s]);
+	}
+}
+
+void Secp256K1::AddGroupN(int nbStream, const Point* p, const PointK1& g, const IntK1* const* dx, PointK1* const* pp, PointK1* const* pn)
+{
+	switch (nbStream)
+	{
+		case 1:
+			AddGroupK1(p[0], g, *dx[0], *pp[0], *pn[0]);
+			break;
+		case 2:
+			AddGroupK1N<2>(p, g, dx, pp, pn);
+			break;
+		case 3:
+			AddGroupK1N<3>(p, g, dx, pp, pn);
+			break;
+		case 4:
+			AddGroupK1N<4>(p, g, dx, pp, pn);
+			break;
+	}
+}
+
+void Secp256K1::AddGroupT(int backend, const Point& p, const PointK1* g, const IntK1* dx, PointK1* pp, PointK1* pn)
+{
+	if (backend == FIELD_SCALAR)
+	{
+		AddGroupK1(p, g[0], dx[0], pp[0], pn[0]);
+		return;
+	}
+
+	uint64_t* gx[8];
+	uint64_t* gy[8];
+	uint64_t* d[8];
+	uint64_t* ppx[8];
+	uint64_t* ppy[8];
+	uint64_t* pnx[8];
+	uint64_t* pny[8];
+	int n = GetFieldBackendWidth(backend);
+
+	for (int j = 0; j < n; j++)
+	{
+		gx[j] = (uint64_t*)g[j].x.bits64;
+		gy[j] = (uint64_t*)g[j].y.bits64;
+		d[j] = (uint64_t*)dx[j].bits64;
+		ppx[j] = pp[j].x.bits64;
+		ppy[j] = pp[j].y.bits64;
+		pnx[j] = pn[-j].x.bits64;
+		pny[j] = pn[-j].y.bits64;
+	}
+
+	switch (backend)
+	{
+		case FIELD_AVX2:
+			::AddGroup4((uint64_t*)p.x.bits64, (uint64_t*)p.y.bits64, gx, gy, d, ppx, ppy, pnx, pny);
+			break;
+		case FIELD_IFMA:
+			::AddGroup8((uint64_t*)p.x.bits64, (uint64_t*)p.y.bits64, gx, gy, d, ppx, ppy, pnx, pny);
+			break;
+	}
+}
+
 Point Secp256K1::ComputePublicKey(const Int& privKey)
 {
 	int i = 0;
-	uint8_t b;
+	uint32_t b;
 	Point Q;
 	Q.Clear();
 
-	// Search first significant byte
-	for (i = 0; i < 32; i++)
+	// Point at infinity
+	if (privKey.IsZero())
+		return Q;
+
+	// Search first significant window
+	for (i = 0; i < gtableNbWindow; i++)
 	{
-		b = privKey.GetByte(i);
+		b = GetWindow(privKey, i);
 		if (b)
 		{
 			break;
 		}
 	}
-	Q = GTable[256 * i + (b - 1)];
+	GTable[(i << gtableWindow) + (b - 1)].Get(Q);
 	i++;
 
-	for (; i < 32; i++)
+	Point T;
+	for (; i < gtableNbWindow; i++)
 	{
-		b = privKey.GetByte(i);
+		b = GetWindow(privKey, i);
 		if (b)
 		{
-			Q = Add2(Q, GTable[256 * i + (b - 1)]);
+			GTable[(i << gtableWindow) + (b - 1)].Get(T);
+			Q = Add2(Q, T);
 		}
 	}
 
@@ -248,6 +1117,208 @@ Point Secp256K1::ComputePublicKey(const Int& privKey)
 	return Q;
 }
 
+// Batch of public keys: the keys are processed one GTable window at a time and
+// each window adds its GTable point to all the keys with an affine addition,
+// the inversions of a window are shared (IntGroup). Keys which hit a degenerate
+// case (Q = +/-T) are computed by ComputePublicKey(), a null key gives the offset
+// or the point at infinity.
+static void ComputePublicKeyBlock(const Int* keys, Point* out, int n, const Point* offset)
+{
+	IntGroup grp(n);
+	IntK1* dx = new IntK1[n];
+	uint8_t* state = new uint8_t[n];   // 0: point at infinity, 1: running, 2: degenerate
+	uint8_t* add = new uint8_t[n];     // Addition pending in the current window
+	Int one((uint64_t)1);
+	Int d;
+	Int dy;
+	Int _s;
+	Int _p;
+	Point T;
+	int k;
+
+	memset(state, 0, n);
+
+	int nbWindow = Secp256K1::gtableNbWindow;
+	int window = Secp256K1::gtableWindow;
+
+	for (int i = 0; i <= nbWindow; i++)
+	{
+		bool hasAdd = false;
+
+		// Last window is the optional offset
+		if (i == nbWindow && offset == NULL)
+			break;
+
+		for (k = 0; k < n; k++)
+		{
+			dx[k].Set(one);
+			add[k] = 0;
+			if (state[k] == 2)
+				continue;
+			if (i < nbWindow)
+			{
+				uint32_t b = Secp256K1::GetWindow(keys[k], i);
+				if (!b)
+					continue;
+				Secp256K1::GTable[(i << window) + (b - 1)].Get(T);
+			}
+			else
+			{
+				if (state[k] == 0)
+					continue;
+				T = *offset;
+			}
+			if (state[k] == 0)
+			{
+				out[k] = T;
+				state[k] = 1;
+				continue;
+			}
+			d.ModSub(T.x, out[k].x);
+			if (d.IsZero())
+			{
+				state[k] = 2;
+				continue;
+			}
+			dx[k].Set(d);
+			add[k] = 1;
+			hasAdd = true;
+		}
+
+		if (!hasAdd)
+			continue;
+
+		grp.Set(dx);
+		grp.ModInv();
+
+		for (k = 0; k < n; k++)
+		{
+			if (!add[k])
+				continue;
+			if (i < nbWindow)
+				Secp256K1::GTable[(i << window) + (Secp256K1::GetWindow(keys[k], i) - 1)].Get(T);
+			else
+				T = *offset;
+
+			dx[k].Get(d);
+			dy.ModSub(T.y, out[k].y);
+			_s.ModMulK1(dy, d);          // s = (T.y-Q.y)/(T.x-Q.x)
+			_p.ModSquareK1(_s);
+
+			d.ModSub(_p, out[k].x);
+			d.ModSub(T.x);               // rx = s^2 - Q.x - T.x
+
+			dy.ModSub(out[k].x, d);
+			dy.ModMulK1(_s);
+			out[k].y.ModSub(dy, out[k].y); // ry = s*(Q.x-rx) - Q.y
+			out[k].x.Set(d);
+		}
+	}
+
+	for (k = 0; k < n; k++)
+	{
+		if (state[k] != 1)
+		{
+			if (keys[k].IsZero())
+			{
+				// Null key: offset or point at infinity
+				if (offset)
+					out[k] = *offset;
+				else
+					out[k].Clear();
+			}
+			else
+			{
+				out[k] = Secp256K1::ComputePublicKey(keys[k]);
+				if (offset)
+				{
+					if (!out[k].x.IsEqual(offset->x))
+						out[k] = Secp256K1::AddDirect(out[k], *offset);
+					else if (out[k].y.IsEqual(offset->y))
+						out[k] = Secp256K1::DoubleDirect(out[k]);
+					else
+						out[k].Clear(); // Q = -offset
+				}
+			}
+			if (out[k].isZero())
+				continue;
+		}
+		out[k].z.SetInt32(1);
+	}
+
+	delete[] add;
+	delete[] state;
+	delete[] dx;
+}
+
+typedef struct {
+
+	const Int* keys;
+	Point* out;
+	int n;
+	const Point* offset;
+
+} PUBKEY_BLOCK;
+
+#ifdef WIN64
+static DWORD WINAPI _ComputePublicKeyBlock(LPVOID lpParam) {
+#else
+static void* _ComputePublicKeyBlock(void* lpParam) {
+#endif
+	PUBKEY_BLOCK* p = (PUBKEY_BLOCK*)lpParam;
+	ComputePublicKeyBlock(p->keys, p->out, p->n, p->offset);
+	return 0;
+}
+
+void Secp256K1::ComputePublicKeyBatch(const Int* keys, Point* out, int n, const Point* offset, int nbThread)
+{
+	// Keep blocks large enough to amortize the inversions
+	if (nbThread > n / 256)
+		nbThread = n / 256;
+	if (nbThread <= 1)
+	{
+		ComputePublicKeyBlock(keys, out, n, offset);
+		return;
+	}
+
+	PUBKEY_BLOCK* blocks = new PUBKEY_BLOCK[nbThread];
+#ifdef WIN64
+	HANDLE* threads = new HANDLE[nbThread];
+#else
+	pthread_t* threads = new pthread_t[nbThread];
+#endif
+
+	int pos = 0;
+	for (int t = 0; t < nbThread; t++)
+	{
+		int size = n / nbThread + ((t < n % nbThread) ? 1 : 0);
+		blocks[t].keys = keys + pos;
+		blocks[t].out = out + pos;
+		blocks[t].n = size;
+		blocks[t].offset = offset;
+		pos += size;
+#ifdef WIN64
+		DWORD thread_id;
+		threads[t] = CreateThread(NULL, 0, _ComputePublicKeyBlock, (void*)(blocks + t), 0, &thread_id);
+#else
+		pthread_create(threads + t, NULL, &_ComputePublicKeyBlock, (void*)(blocks + t));
+#endif
+	}
+
+	for (int t = 0; t < nbThread; t++)
+	{
+#ifdef WIN64
+		WaitForSingleObject(threads[t], INFINITE);
+		CloseHandle(threads[t]);
+#else
+		pthread_join(threads[t], NULL);
+#endif
+	}
+
+	delete[] threads;
+	delete[] blocks;
+}
+
 Point Secp256K1::NextKey(const Point& key)
 {
 	// Input key must be reduced and different from G
@@ -390,101 +1461,235 @@ Int Secp256K1::DecodePrivateKey(char* key, bool* compressed)
 (buff)[30] = 0; \
 (buff)[31] = 0x208;
 
-#define KEYBUFFSCRIPT(buff,h) \
-(buff)[0] = 0x00140000 | (uint32_t)h[0] << 8 | (uint32_t)h[1]; \
-(buff)[1] = (uint32_t)h[2] << 24 | (uint32_t)h[3] << 16 | (uint32_t)h[4] << 8 | (uint32_t)h[5];\
-(buff)[2] = (uint32_t)h[6] << 24 | (uint32_t)h[7] << 16 | (uint32_t)h[8] << 8 | (uint32_t)h[9];\
-(buff)[3] = (uint32_t)h[10] << 24 | (uint32_t)h[11] << 16 | (uint32_t)h[12] << 8 | (uint32_t)h[13];\
-(buff)[4] = (uint32_t)h[14] << 24 | (uint32_t)h[15] << 16 | (uint32_t)h[16] << 8 | (uint32_t)h[17];\
-(buff)[5] = (uint32_t)h[18] << 24 | (uint32_t)h[19] << 16 | 0x8000; \
-(buff)[6] = 0; \
-(buff)[7] = 0; \
-(buff)[8] = 0; \
-(buff)[9] = 0; \
-(buff)[10] = 0; \
-(buff)[11] = 0; \
-(buff)[12] = 0; \
-(buff)[13] = 0; \
-(buff)[14] = 0; \
-(buff)[15] = 0xB0;
+// Hash 16 points with the SSE, AVX2 or AVX-512 kernels: the sha256 digests stay
+// lane-transposed (32 bits word w of lane j at w * n + j) from the sha256 state
+// to the RIPEMD160 message words, no transpose and no byte buffer in between.
+static void Hash160T(int backend, int len, uint32_t** b, uint32_t* h)
+{
+#ifdef WIN64
+	__declspec(align(64)) uint32_t sh[8 * 16];
+#else
+	uint32_t sh[8 * 16] __attribute__((aligned(64)));
+#endif
+
+	// The sha256 kernels are specialized on the message length (33 or 65 bytes)
+	switch (backend)
+	{
+		case HASH_AVX512:
+			switch (len)
+			{
+				case 65: sha256avx512_65_t(b, sh); break;
+				default: sha256avx512_33_t(b, sh); break;
+			}
+			ripemd160avx512_32_t(sh, h);
+			break;
+
+		case HASH_AVX2:
+			switch (len)
+			{
+				case 65: sha256avx2_65_t(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], sh); break;
+				default: sha256avx2_33_t(b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], sh); break;
+			}
+			ripemd160avx2_32_t(sh, h);
+			break;
+
+		default:
+			switch (len)
+			{
+				case 65: sha256sse_65_t(b[0], b[1], b[2], b[3], sh); break;
+				default: sha256sse_33_t(b[0], b[1], b[2], b[3], sh); break;
+			}
+			ripemd160sse_32_t(sh, h);
+			break;
+	}
+}
+
+// P2SH: hash the redeem scripts of the lane-transposed P2PKH hash160 kh, the
+// scripts are built in the sha256 kernel, no byte buffer and no transpose.
+static void Hash160TScript(int backend, uint32_t* kh, uint32_t* h)
+{
+#ifdef WIN64
+	__declspec(align(64)) uint32_t sh[8 * 16];
+#else
+	uint32_t sh[8 * 16] __attribute__((aligned(64)));
+#endif
+
+	switch (backend)
+	{
+		case HASH_AVX512:
+			sha256avx512_p2sh_t(kh, sh);
+			ripemd160avx512_32_t(sh, h);
+			break;
+
+		case HASH_AVX2:
+			sha256avx2_p2sh_t(kh, sh);
+			ripemd160avx2_32_t(sh, h);
+			break;
 
-void Secp256K1::GetHash160(int type, bool compressed, const Point& k0, const Point& k1, const Point& k2, const Point& k3, uint8_t* h0, uint8_t* h1, uint8_t* h2, uint8_t* h3)
+		default:
+			sha256sse_p2sh_t(kh, sh);
+			ripemd160sse_32_t(sh, h);
+			break;
+	}
+}
+
+// Points are read through x.bits32, y.bits32 and y.IsOdd() (Point or PointK1),
+// the address type and the key format are resolved at compile time
+template<class P, int type, bool compressed>
+static void GetHash160TP(int backend, const P* k, uint32_t* h)
 {
+	int n = Secp256K1::GetHashBackendWidth(backend);
+	uint32_t* bi[16];
+
+	if (type == P2SH)
+	{
 #ifdef WIN64
-	__declspec(align(16)) unsigned char sh0[64];
-	__declspec(align(16)) unsigned char sh1[64];
-	__declspec(align(16)) unsigned char sh2[64];
-	__declspec(align(16)) unsigned char sh3[64];
+		__declspec(align(64)) uint32_t kh[5 * 16];
 #else
-	unsigned char sh0[64] __attribute__((aligned(16)));
-	unsigned char sh1[64] __attribute__((aligned(16)));
-	unsigned char sh2[64] __attribute__((aligned(16)));
-	unsigned char sh3[64] __attribute__((aligned(16)));
+		uint32_t kh[5 * 16] __attribute__((aligned(64)));
 #endif
 
-	switch (type)
+		GetHash160TP<P, P2PKH, compressed>(backend, k, kh);
+		Hash160TScript(backend, kh, h);
+	}
+	else if (!compressed)
 	{
-		case P2PKH:
-		case BECH32:
+		uint32_t b[16][32];
+
+		for (int i = 0; i < n; i++)
 		{
-			if (!compressed)
-			{
-				uint32_t b0[32];
-				uint32_t b1[32];
-				uint32_t b2[32];
-				uint32_t b3[32];
-
-				KEYBUFFUNCOMP(b0, k0);
-				KEYBUFFUNCOMP(b1, k1);
-				KEYBUFFUNCOMP(b2, k2);
-				KEYBUFFUNCOMP(b3, k3);
-
-				sha256sse_2B(b0, b1, b2, b3, sh0, sh1, sh2, sh3);
-				ripemd160sse_32(sh0, sh1, sh2, sh3, h0, h1, h2, h3);
-			}
-			else
-			{
-				uint32_t b0[16];
-				uint32_t b1[16];
-				uint32_t b2[16];
-				uint32_t b3[16];
-
-				KEYBUFFCOMP(b0, k0);
-				KEYBUFFCOMP(b1, k1);
-				KEYBUFFCOMP(b2, k2);
-				KEYBUFFCOMP(b3, k3);
-
-				sha256sse_1B(b0, b1, b2, b3, sh0, sh1, sh2, sh3);
-				ripemd160sse_32(sh0, sh1, sh2, sh3, h0, h1, h2, h3);
-			}
+			KEYBUFFUNCOMP(b[i], k[i]);
+			bi[i] = b[i];
 		}
-		break;
+		Hash160T(backend, 65, bi, h);
+	}
+	else
+	{
+		uint32_t b[16][16];
 
-		case P2SH:
+		for (int i = 0; i < n; i++)
 		{
-			unsigned char kh0[20];
-			unsigned char kh1[20];
-			unsigned char kh2[20];
-			unsigned char kh3[20];
+			KEYBUFFCOMP(b[i], k[i]);
+			bi[i] = b[i];
+		}
+		Hash160T(backend, 33, bi, h);
+	}
+}
+
+// P2PKH and BECH32 share the hash160
+template<class P>
+static void GetHash160TP(int backend, int type, bool compressed, const P* k, uint32_t* h)
+{
+	if (type == P2SH)
+	{
+		if (compressed) GetHash160TP<P, P2SH, true>(backend, k, h);
+		else GetHash160TP<P, P2SH, false>(backend, k, h);
+	}
+	else
+	{
+		if (compressed) GetHash160TP<P, P2PKH, true>(backend, k, h);
+		else GetHash160TP<P, P2PKH, false>(backend, k, h);
+	}
+}
+
+void Secp256K1::GetHash160T(int backend, int type, bool compressed, const Point* k, uint32_t* h)
+{
+	GetHash160TP(backend, type, compressed, k, h);
+}
 
-			GetHash160(P2PKH, compressed, k0, k1, k2, k3, kh0, kh1, kh2, kh3);
+void Secp256K1::GetHash160T(int backend, int type, bool compressed, const PointK1* k, uint32_t* h)
+{
+	GetHash160TP(backend, type, compressed, k, h);
+}
 
-			// Redeem Script (1 to 1 P2SH)
-			uint32_t b0[16];
-			uint32_t b1[16];
-			uint32_t b2[16];
-			uint32_t b3[16];
+template<int type, bool compressed>
+void Secp256K1::GetHash160T(int backend, const PointK1* k, uint32_t* h)
+{
+	GetHash160TP<PointK1, type, compressed>(backend, k, h);
+}
+
+template void Secp256K1::GetHash160T<P2PKH, true>(int backend, const PointK1* k, uint32_t* h);
+template void Secp256K1::GetHash160T<P2PKH, false>(int backend, const PointK1* k, uint32_t* h);
+template void Secp256K1::GetHash160T<P2SH, true>(int backend, const PointK1* k, uint32_t* h);
+template void Secp256K1::GetHash160T<P2SH, false>(int backend, const PointK1* k, uint32_t* h);
+template void Secp256K1::GetHash160T<BECH32, true>(int backend, const PointK1* k, uint32_t* h);
+template void Secp256K1::GetHash160T<BECH32, false>(int backend, const PointK1* k, uint32_t* h);
+
+// Lane j of a lane-transposed hash160 (see GetHash160T) to bytes
+#define DEPACKT(d,h,n,j) \
+((uint32_t *)(d))[0] = (h)[(j)]; \
+((uint32_t *)(d))[1] = (h)[(n) + (j)]; \
+((uint32_t *)(d))[2] = (h)[2 * (n) + (j)]; \
+((uint32_t *)(d))[3] = (h)[3 * (n) + (j)]; \
+((uint32_t *)(d))[4] = (h)[4 * (n) + (j)];
+
+void Secp256K1::GetHash160(int type, bool compressed, const Point& k0, const Point& k1, const Point& k2, const Point& k3, uint8_t* h0, uint8_t* h1, uint8_t* h2, uint8_t* h3)
+{
+	Point k[4] = { k0, k1, k2, k3 };
+	uint32_t h[5 * 4];
+
+	GetHash160T(HASH_SSE, type, compressed, k, h);
+	DEPACKT(h0, h, 4, 0);
+	DEPACKT(h1, h, 4, 1);
+	DEPACKT(h2, h, 4, 2);
+	DEPACKT(h3, h, 4, 3);
+}
+
+void Secp256K1::GetHash160(int type, bool compressed,
+	const Point& k0, const Point& k1, const Point& k2, const Point& k3,
+	const Point& k4, const Point& k5, const Point& k6, const Point& k7,
+	uint8_t* h0, uint8_t* h1, uint8_t* h2, uint8_t* h3,
+	uint8_t* h4, uint8_t* h5, uint8_t* h6, uint8_t* h7)
+{
+	Point k[8] = { k0, k1, k2, k3, k4, k5, k6, k7 };
+	uint32_t h[5 * 8];
+
+	GetHash160T(HASH_AVX2, type, compressed, k, h);
+	DEPACKT(h0, h, 8, 0);
+	DEPACKT(h1, h, 8, 1);
+	DEPACKT(h2, h, 8, 2);
+	DEPACKT(h3, h, 8, 3);
+	DEPACKT(h4, h, 8, 4);
+	DEPACKT(h5, h, 8, 5);
+	DEPACKT(h6, h, 8, 6);
+	DEPACKT(h7, h, 8, 7);
+}
+
+void Secp256K1::GetHash160x16(int type, bool compressed, const Point* k, uint8_t h[16][20])
+{
+	uint32_t ht[5 * 16];
+
+	GetHash160T(HASH_AVX512, type, compressed, k, ht);
+	for (int i = 0; i < 16; i++)
+	{
+		DEPACKT(h[i], ht, 16, i);
+	}
+}
 
-			KEYBUFFSCRIPT(b0, kh0);
-			KEYBUFFSCRIPT(b1, kh1);
-			KEYBUFFSCRIPT(b2, kh2);
-			KEYBUFFSCRIPT(b3, kh3);
+void Secp256K1::GetHash160Batch(int type, bool compressed, const Point* pts, size_t n, uint8_t (*out)[20])
+{
+	static const int best = GetHashBackend();
+	uint32_t h[5 * 16];
+	size_t i = 0;
 
-			sha256sse_1B(b0, b1, b2, b3, sh0, sh1, sh2, sh3);
-			ripemd160sse_32(sh0, sh1, sh2, sh3, h0, h1, h2, h3);
+	// A CPU supporting a backend also supports the narrower ones
+	for (int b = best; b > HASH_SCALAR; b--)
+	{
+		size_t w = GetHashBackendWidth(b);
+		for (; i + w <= n; i += w)
+		{
+			GetHash160T(b, type, compressed, pts + i, h);
+			for (size_t j = 0; j < w; j++)
+			{
+				DEPACKT(out[i + j], h, w, j);
+			}
 		}
-		break;
 	}
+
+	for (; i + 2 <= n; i += 2)
+		GetHash160(type, compressed, pts[i], pts[i + 1], out[i], out[i + 1]);
+	if (i < n)
+		GetHash160(type, compressed, pts[i], out[i]);
 }
 
 uint8_t Secp256K1::GetByte(const std::string& str, int idx)
@@ -753,6 +1958,437 @@ void Secp256K1::GetHash160(int type, bool compressed, const Point& pubKey, unsig
 	}
 }
 
+template<int type, bool compressed>
+void Secp256K1::GetHash160(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1)
+{
+	unsigned char sh0[64];
+	unsigned char sh1[64];
+
+	if (type == P2SH)
+	{
+		// Redeem Script (1 to 1 P2SH)
+		unsigned char s0[64];
+		unsigned char s1[64];
+
+		s0[0] = 0x00;  // OP_0
+		s0[1] = 0x14;  // PUSH 20 bytes
+		s1[0] = 0x00;
+		s1[1] = 0x14;
+		GetHash160<P2PKH, compressed>(k0, k1, s0 + 2, s1 + 2);
+
+		sha256(s0, 22, sh0);
+		sha256(s1, 22, sh1);
+	}
+	else
+	{
+		unsigned char b0[128];
+		unsigned char b1[128];
+		if (!compressed)
+		{
+			// Full public key
+			b0[0] = 0x4;
+			k0.x.Get32Bytes(b0 + 1);
+			k0.y.Get32Bytes(b0 + 33);
+			b1[0] = 0x4;
+			k1.x.Get32Bytes(b1 + 1);
+			k1.y.Get32Bytes(b1 + 33);
+			sha256_65_2w(b0, b1, sh0, sh1);
+		}
+		else
+		{
+			// Compressed public key
+			b0[0] = k0.y.IsEven() ? 0x2 : 0x3;
+			k0.x.Get32Bytes(b0 + 1);
+			b1[0] = k1.y.IsEven() ? 0x2 : 0x3;
+			k1.x.Get32Bytes(b1 + 1);
+			sha256_33_2w(b0, b1, sh0, sh1);
+		}
+	}
+	ripemd160_32(sh0, h0);
+	ripemd160_32(sh1, h1);
+}
+
+template void Secp256K1::GetHash160<P2PKH, true>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+template void Secp256K1::GetHash160<P2PKH, false>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+template void Secp256K1::GetHash160<P2SH, true>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+template void Secp256K1::GetHash160<P2SH, false>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+template void Secp256K1::GetHash160<BECH32, true>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+template void Secp256K1::GetHash160<BECH32, false>(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+
+void Secp256K1::GetHash160(int type, bool compressed, const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1)
+{
+	if (type == P2SH)
+	{
+		if (compressed) GetHash160<P2SH, true>(k0, k1, h0, h1);
+		else GetHash160<P2SH, false>(k0, k1, h0, h1);
+	}
+	else
+	{
+		if (compressed) GetHash160<P2PKH, true>(k0, k1, h0, h1);
+		else GetHash160<P2PKH, false>(k0, k1, h0, h1);
+	}
+}
+
+// Check the single and 2-way sha256 against the SSE multi-buffer kernel
+bool Secp256K1::CheckSha256()
+{
+	uint8_t m[4][128];
+	uint8_t d[4][32];
+	uint8_t sh[4][32];
+	uint32_t b[4][32];
+	Point p[4];
+
+	// FIPS 180-2 test vector
+	const char* abc = "abc";
+	const uint8_t abcDigest[] = {
+		0xba,0x78,0x16,0xbf,0x8f,0x01,0xcf,0xea,0x41,0x41,0x40,0xde,0x5d,0xae,0x22,0x23,
+		0xb0,0x03,0x61,0xa3,0x96,0x17,0x7a,0x9c,0xb4,0x10,0xff,0x61,0xf2,0x00,0x15,0xad };
+	sha256((const uint8_t*)abc, 3, d[0]);
+	if (memcmp(d[0], abcDigest, 32) != 0)
+		return false;
+
+	for (int r = 0; r < 16; r++)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			Int k;
+			k.Rand(256);
+			p[i] = ComputePublicKey(k);
+		}
+
+		// Compressed
+		for (int i = 0; i < 4; i++)
+		{
+			KEYBUFFCOMP(b[i], p[i]);
+			m[i][0] = p[i].y.IsEven() ? 0x2 : 0x3;
+			p[i].x.Get32Bytes(m[i] + 1);
+		}
+		sha256sse_1B(b[0], b[1], b[2], b[3], sh[0], sh[1], sh[2], sh[3]);
+		sha256_33(m[0], d[0]);
+		sha256_33(m[1], d[1]);
+		sha256_33_2w(m[2], m[3], d[2], d[3]);
+		for (int i = 0; i < 4; i++)
+			if (memcmp(d[i], sh[i], 32) != 0)
+				return false;
+
+		// Uncompressed
+		for (int i = 0; i < 4; i++)
+		{
+			KEYBUFFUNCOMP(b[i], p[i]);
+			m[i][0] = 0x4;
+			p[i].x.Get32Bytes(m[i] + 1);
+			p[i].y.Get32Bytes(m[i] + 33);
+		}
+		sha256sse_2B(b[0], b[1], b[2], b[3], sh[0], sh[1], sh[2], sh[3]);
+		sha256_65(m[0], d[0]);
+		sha256_65(m[1], d[1]);
+		sha256_65_2w(m[2], m[3], d[2], d[3]);
+		for (int i = 0; i < 4; i++)
+			if (memcmp(d[i], sh[i], 32) != 0)
+				return false;
+	}
+
+	return true;
+}
+
+// Compressed public key sha256 throughput: SSE 4-way vs single message
+void Secp256K1::BenchSha256()
+{
+	uint8_t m[4][64];
+	uint8_t d[4][32];
+	uint32_t b[4][16];
+	const int nbTry = 65536;
+	const char* name = sha256_shani_enabled() ? "sha-ni" : "scalar";
+
+	Int k;
+	k.Rand(256);
+	Point p = ComputePublicKey(k);
+	for (int i = 0; i < 4; i++)
+	{
+		KEYBUFFCOMP(b[i], p);
+		m[i][0] = p.y.IsEven() ? 0x2 : 0x3;
+		p.x.Get32Bytes(m[i] + 1);
+		p = NextKey(p);
+	}
+
+	printf("Bench sha256 (sse) : ");
+	double t0 = Timer::get_tick();
+	for (int i = 0; i < nbTry; i++)
+		sha256sse_1B(b[0], b[1], b[2], b[3], d[0], d[1], d[2], d[3]);
+	double t1 = Timer::get_tick();
+	Timer::printResult((char*)"Sha256", 4 * nbTry, t0, t1);
+
+	printf("Bench sha256 (%s) : ", name);
+	t0 = Timer::get_tick();
+	for (int i = 0; i < nbTry; i++)
+		for (int j = 0; j < 4; j++)
+			sha256_33(m[j], d[j]);
+	t1 = Timer::get_tick();
+	Timer::printResult((char*)"Sha256", 4 * nbTry, t0, t1);
+
+	printf("Bench sha256 (%s 2-way) : ", name);
+	t0 = Timer::get_tick();
+	for (int i = 0; i < nbTry; i++)
+	{
+		sha256_33_2w(m[0], m[1], d[0], d[1]);
+		sha256_33_2w(m[2], m[3], d[2], d[3]);
+	}
+	t1 = Timer::get_tick();
+	Timer::printResult((char*)"Sha256", 4 * nbTry, t0, t1);
+}
+
+// r[j] = a[j]*b[j] or a[j]^2 (b = NULL) using a vectorized field backend
+static void ModMulK1T(int backend, Int* r, const Int* a, const Int* b)
+{
+	uint64_t* _r[8];
+	uint64_t* _a[8];
+	uint64_t* _b[8];
+	int n = Secp256K1::GetFieldBackendWidth(backend);
+
+	for (int j = 0; j < n; j++)
+	{
+		_r[j] = r[j].bits64;
+		_a[j] = (uint64_t*)a[j].bits64;
+		_b[j] = (uint64_t*)(b ? b[j].bits64 : a[j].bits64);
+	}
+
+	switch (backend)
+	{
+		case FIELD_AVX2:
+			if (b) ModMulK1x4(_r, _a, _b);
+			else   ModSquareK1x4(_r, _a);
+			break;
+		case FIELD_IFMA:
+			if (b) ModMulK1x8(_r, _a, _b);
+			else   ModSquareK1x8(_r, _a);
+			break;
+	}
+
+	for (int j = 0; j < n; j++)
+		r[j].bits64[4] = 0;
+}
+
+bool Secp256K1::CheckField(int backend)
+{
+	Int P = Int::GetFieldCharacteristic();
+	Int a[8], b[8], r[8], c;
+	int n = GetFieldBackendWidth(backend);
+
+	// Vectorized ModMulK1/ModSquareK1
+	for (int k = 0; k < 1024 && backend != FIELD_SCALAR; k++)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			a[j].Rand(P);
+			b[j].Rand(P);
+		}
+		if (k == 0)
+		{
+			// Limits
+			a[0].Set(P); a[0].SubOne();
+			b[0].Set(a[0]);
+			a[1].SetInt32(0);
+			b[2].SetInt32(1);
+		}
+
+		ModMulK1T(backend, r, a, b);
+		for (int j = 0; j < n; j++)
+		{
+			c.ModMulK1(a[j], b[j]);
+			if (c.IsGreaterOrEqual(P))	// ModMulK1 is not fully reduced
+				c.Sub(P);
+			if (!c.IsEqual(r[j]))
+				return false;
+		}
+
+		ModMulK1T(backend, r, a, NULL);
+		for (int j = 0; j < n; j++)
+		{
+			c.ModSquareK1(a[j]);
+			if (c.IsGreaterOrEqual(P))
+				c.Sub(P);
+			if (!c.IsEqual(r[j]))
+				return false;
+		}
+	}
+
+	// Group walk
+	Point p, g[8];
+	PointK1 gk[8], pp[8], pn[8];
+	IntK1 dx[8];
+	for (int k = 0; k < 64; k++)
+	{
+		Int e, d;
+		e.Rand(256);
+		p = ComputePublicKey(e);
+		for (int j = 0; j < n; j++)
+		{
+			e.Rand(256);
+			g[j] = ComputePublicKey(e);
+			gk[j].Set(g[j]);
+			d.ModSub(g[j].x, p.x);
+			d.ModInv();
+			dx[j].Set(d);
+		}
+
+		AddGroupT(backend, p, gk, dx, pp, pn + n - 1);
+		for (int j = 0; j < n; j++)
+		{
+			Point q = AddDirect(p, g[j]);
+			if (!pp[j].x.IsEqual(q.x) || !pp[j].y.IsEqual(q.y))
+				return false;
+			q = SubDirect(p, g[j]);
+			if (!pn[n - 1 - j].x.IsEqual(q.x) || !pn[n - 1 - j].y.IsEqual(q.y))
+				return false;
+		}
+	}
+
+	// Batch inversion (chains of unequal length, fewer elements than chains)
+	const int sizes[] = { 1, 3, 7, 9, 20, 513 };
+	IntK1 m[513];
+	Int v[513];
+	for (int k = 0; k < 6; k++)
+	{
+		IntGroup grp(sizes[k], backend);
+		grp.Set(m);
+		for (int i = 0; i < sizes[k]; i++)
+		{
+			v[i].Rand(P);
+			m[i].Set(v[i]);
+		}
+		grp.ModInv();
+		for (int i = 0; i < sizes[k]; i++)
+		{
+			// v * v^-1 = 1
+			m[i].Get(c);
+			c.ModMulK1(v[i]);
+			if (c.IsGreaterOrEqual(P))
+				c.Sub(P);
+			if (!c.IsOne())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+void Secp256K1::BenchField(int backend)
+{
+	Int P = Int::GetFieldCharacteristic();
+	Int a[8], b[8];
+	const int nbTry = 65536;
+	const char* name = GetFieldBackendName(backend);
+	int n = GetFieldBackendWidth(backend);
+
+	for (int j = 0; j < 8; j++)
+	{
+		a[j].Rand(P);
+		b[j].Rand(P);
+	}
+
+	printf("Bench ModMulK1 (%s) : ", name);
+	double t0 = Timer::get_tick();
+	if (backend == FIELD_SCALAR)
+	{
+		for (int i = 0; i < nbTry; i++)
+			for (int j = 0; j < 8; j++)
+				a[j].ModMulK1(b[j]);
+	}
+	else
+	{
+		for (int i = 0; i < nbTry * 8 / n; i++)
+			ModMulK1T(backend, a, a, b);
+	}
+	double t1 = Timer::get_tick();
+	Timer::printResult((char*)"Mul", 8 * nbTry, t0, t1);
+
+	// One step of the CPU group walk (P+G and P-G) for 8 points
+	Point p, g[8], pp[8], pn[8];
+	PointK1 gk[8], ppk[8], pnk[8];
+	Int dx[8];
+	IntK1 dxk[8];
+	Int k;
+	k.Rand(256);
+	p = ComputePublicKey(k);
+	k.Rand(256);
+	for (int j = 0; j < 8; j++)
+	{
+		g[j] = ComputePublicKey(k);
+		gk[j].Set(g[j]);
+		k.AddOne();
+		dx[j].ModSub(g[j].x, p.x);
+		dx[j].ModInv();
+		dxk[j].Set(dx[j]);
+	}
+
+	if (backend == FIELD_SCALAR)
+	{
+		// Fully reduced ModSub/ModAdd/ModNeg chain
+		printf("Bench group walk (%s ModSub) : ", name);
+		t0 = Timer::get_tick();
+		for (int i = 0; i < nbTry / 8; i++)
+		{
+			for (int j = 0; j < 8; j++)
+			{
+				Int dy, _s, _p;
+
+				pp[j] = p;
+				dy.ModSub(g[j].y, pp[j].y);
+				_s.ModMulK1(dy, dx[j]);
+				_p.ModSquareK1(_s);
+				pp[j].x.ModNeg();
+				pp[j].x.ModAdd(_p);
+				pp[j].x.ModSub(g[j].x);
+				pp[j].y.ModSub(g[j].x, pp[j].x);
+				pp[j].y.ModMulK1(_s);
+				pp[j].y.ModSub(g[j].y);
+
+				pn[j] = p;
+				dy.Set(g[j].y);
+				dy.ModNeg();
+				dy.ModSub(pn[j].y);
+				_s.ModMulK1(dy, dx[j]);
+				_p.ModSquareK1(_s);
+				pn[j].x.ModNeg();
+				pn[j].x.ModAdd(_p);
+				pn[j].x.ModSub(g[j].x);
+				pn[j].y.ModSub(g[j].x, pn[j].x);
+				pn[j].y.ModMulK1(_s);
+				pn[j].y.ModAdd(g[j].y);
+			}
+		}
+		t1 = Timer::get_tick();
+		Timer::printResult((char*)"Point", 2 * nbTry, t0, t1);
+	}
+
+	printf("Bench group walk (%s) : ", name);
+	t0 = Timer::get_tick();
+	for (int i = 0; i < nbTry / n; i++)
+		AddGroupT(backend, p, gk + (i % (8 / n)) * n, dxk + (i % (8 / n)) * n, ppk, pnk + n - 1);
+	t1 = Timer::get_tick();
+	Timer::printResult((char*)"Point", 2 * nbTry, t0, t1);
+
+	// Batch inversion of a CPU group (CPU_GRP_SIZE/2+1 = 513 elements)
+	const int grpSize = 513;
+	const int nbGroup = 256;
+	IntK1* m = new IntK1[grpSize];
+	IntGroup grp(grpSize, backend);
+	grp.Set(m);
+	for (int i = 0; i < grpSize; i++)
+	{
+		a[0].Rand(P);
+		m[i].Set(a[0]);
+	}
+
+	printf("Bench IntGroup.ModInv (%s) : ", name);
+	t0 = Timer::get_tick();
+	for (int i = 0; i < nbGroup; i++)
+		grp.ModInv();
+	t1 = Timer::get_tick();
+	Timer::printResult((char*)"Inv", grpSize * nbGroup, t0, t1);
+	delete[] m;
+}
+
 std::string Secp256K1::GetPrivAddress(bool compressed, Int& privKey)
 {
 	unsigned char address[38];
@@ -1242,6 +2878,263 @@ Point Secp256K1::MulDirect(const Point& p, const Int& s)
 	return r;
 }
 
+// GLV decomposition constants (k = k1 + k2.lambda1 (mod n), |k1|,|k2| < 2^129)
+// c1 = round(k.g1 / 2^384), c2 = round(k.g2 / 2^384)
+// k2 = c1.(-b1) + c2.(-b2), k1 = k - k2.lambda1
+static const uint64_t glvG1[4] = { 0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL };
+static const uint64_t glvG2[4] = { 0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL };
+static Int glvMinusB1("E4437ED6010E88286F547FA90ABFE4C3");
+static Int glvMinusB2("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFE8A280AC50774346DD765CDA83DB1562C");
+static Int glvMinusLambda("AC9C52B33FA3CF1F5AD9E3FD77ED9BA4A880B9FC8EC739C2E0CFC810B51283CF");
+
+#define GLV_WINDOW 5
+#define GLV_TABLE_SIZE (1 << (GLV_WINDOW - 2))	// P,3P,...,15P
+
+// r = round(k.g / 2^384)
+static void MulShift384(const Int& k, const uint64_t* g, Int& r)
+{
+	uint64_t t[8];
+	uint64_t h;
+	uint64_t l;
+	uint64_t c;
+
+	memset(t, 0, sizeof(t));
+	for (int i = 0; i < 4; i++)
+	{
+		c = 0;
+		for (int j = 0; j < 4; j++)
+		{
+			l = _umul128(k.bits64[i], g[j], &h);
+			l += c;
+			h += (l < c);
+			t[i + j] += l;
+			h += (t[i + j] < l);
+			c = h;
+		}
+		t[i + 4] = c;
+	}
+
+	r.SetInt32(0);
+	r.bits64[0] = t[6];
+	r.bits64[1] = t[7];
+	r.Add(t[5] >> 63);
+}
+
+// Width-w NAF of k (k >= 0), digits are 0 or odd in ]-2^(w-1),2^(w-1)[
+static int GetWNAF(const Int& k, int8_t* digits)
+{
+	Int e(k);
+	int len = 0;
+
+	while (!e.IsZero())
+	{
+		int d = 0;
+		if (e.IsOdd())
+		{
+			d = (int)(e.bits64[0] & ((1 << GLV_WINDOW) - 1));
+			if (d >= (1 << (GLV_WINDOW - 1)))
+			{
+				d -= (1 << GLV_WINDOW);
+				e.Add((uint64_t)(-d));
+			}
+			else
+			{
+				e.Sub((uint64_t)d);
+			}
+		}
+		digits[len++] = (int8_t)d;
+		e.ShiftR(1);
+	}
+
+	return len;
+}
+
+// Jacobian coordinates (x = X/Z^2, y = Y/Z^3) for MulGLV, lazy reduced operands
+// r = 2r (dbl-2009-l, a = 0)
+static void DoubleJ(Point& r)
+{
+	Int a;
+	Int b;
+	Int c;
+	Int d;
+	Int e;
+
+	a.ModSquareK1(r.x);
+	b.ModSquareK1(r.y);
+	c.ModSquareK1(b);
+	d.ModAddK1(r.x, b);
+	d.ModSquareK1(d);
+	d.ModSubK1(a);
+	d.ModSubK1(c);
+	d.ModAddK1(d);             // D = 2((X+B)^2-A-C)
+	e.ModAddK1(a, a);
+	e.ModAddK1(a);             // E = 3A
+
+	r.z.ModMulK1(r.y, r.z);
+	r.z.ModAddK1(r.z);         // Z3 = 2YZ
+	r.x.ModSquareK1(e);
+	r.x.ModSubK1(d);
+	r.x.ModSubK1(d);           // X3 = E^2-2D
+	c.ModAddK1(c);
+	c.ModAddK1(c);
+	c.ModAddK1(c);
+	r.y.ModSubK1(d, r.x);
+	r.y.ModMulK1(e);
+	r.y.ModSubK1(c);           // Y3 = E(D-X3)-8C
+}
+
+// r = r + q, q affine, r != +/-q (madd-2007-bl)
+static void AddJ(Point& r, const Point& q)
+{
+	Int z1z1;
+	Int u2;
+	Int s2;
+	Int h;
+	Int hh;
+	Int i;
+	Int j;
+	Int v;
+	Int w;
+
+	z1z1.ModSquareK1(r.z);
+	u2.ModMulK1(q.x, z1z1);
+	s2.ModMulK1(q.y, r.z);
+	s2.ModMulK1(z1z1);
+	h.ModSubK1(u2, r.x);
+	hh.ModSquareK1(h);
+	i.ModAddK1(hh, hh);
+	i.ModAddK1(i);             // I = 4HH
+	j.ModMulK1(h, i);
+	w.ModSubK1(s2, r.y);
+	w.ModAddK1(w);             // r = 2(S2-Y1)
+	v.ModMulK1(r.x, i);
+
+	r.z.ModAddK1(h);
+	r.z.ModSquareK1(r.z);
+	r.z.ModSubK1(z1z1);
+	r.z.ModSubK1(hh);          // Z3 = (Z1+H)^2-Z1Z1-HH
+	s2.ModMulK1(r.y, j);
+	s2.ModAddK1(s2);           // 2.Y1.J
+	r.x.ModSquareK1(w);
+	r.x.ModSubK1(j);
+	r.x.ModSubK1(v);
+	r.x.ModSubK1(v);           // X3 = r^2-J-2V
+	r.y.ModSubK1(v, r.x);
+	r.y.ModMulK1(w);
+	r.y.ModSubK1(s2);          // Y3 = r(V-X3)-2.Y1.J
+}
+
+// p.s using the endomorphism (GLV): s = k1 + k2.lambda1, the two half size
+// scalars are recoded in wNAF and processed by a single double and add loop
+// in Jacobian coordinates. p must be reduced (z = 1).
+Point Secp256K1::MulGLV(const Point& p, const Int& s)
+{
+	Int k(s);
+	Int k1;
+	Int k2;
+	Int c1;
+	Int c2;
+	Point r;
+
+	if (!k.IsLower(order))
+		k.Sub(order);
+
+	// Decomposition
+	MulShift384(k, glvG1, c1);
+	MulShift384(k, glvG2, c2);
+	c1.ModMulK1order(glvMinusB1);
+	c2.ModMulK1order(glvMinusB2);
+	k2.ModAddK1order(c1, c2);
+	k1.Set(k2);
+	k1.ModMulK1order(glvMinusLambda);
+	k1.ModAddK1order(k);
+
+	bool neg1 = !k1.IsLower(halfOrder);
+	bool neg2 = !k2.IsLower(halfOrder);
+	if (neg1) k1.Sub(order, k1);
+	if (neg2) k2.Sub(order, k2);
+
+	int8_t d1[136];
+	int8_t d2[136];
+	int len1 = GetWNAF(k1, d1);
+	int len2 = GetWNAF(k2, d2);
+
+	// Odd multiples of p (affine, one inversion) and their endomorphism
+	Point t1[GLV_TABLE_SIZE];
+	Point t2[GLV_TABLE_SIZE];
+	IntK1 zs[GLV_TABLE_SIZE];
+	Point p2 = DoubleDirect(p);
+	t1[0] = p;
+	t1[0].z.SetInt32(1);
+	zs[0].Set(t1[0].z);
+	for (int i = 1; i < GLV_TABLE_SIZE; i++)
+	{
+		t1[i] = Add2(t1[i - 1], p2);
+		zs[i].Set(t1[i].z);
+	}
+	IntGroup grp(GLV_TABLE_SIZE);
+	grp.Set(zs);
+	grp.ModInv();
+	for (int i = 0; i < GLV_TABLE_SIZE; i++)
+	{
+		Int zi;
+		zs[i].Get(zi);
+		t1[i].x.ModMulK1(zi);
+		t1[i].y.ModMulK1(zi);
+		t1[i].z.SetInt32(1);
+		t2[i].x.ModMulK1(t1[i].x, beta1);
+		t2[i].y.Set(t1[i].y);
+		t2[i].z.SetInt32(1);
+		if (neg1) t1[i].y.ModNeg();
+		if (neg2) t2[i].y.ModNeg();
+	}
+
+	// Interleaved double and add
+	bool assigned = false;
+	Point T;
+	r.Clear();
+	for (int i = (len1 > len2 ? len1 : len2) - 1; i >= 0; i--)
+	{
+		if (assigned)
+			DoubleJ(r);
+		for (int j = 0; j < 2; j++)
+		{
+			int d = (j == 0) ? ((i < len1) ? d1[i] : 0) : ((i < len2) ? d2[i] : 0);
+			if (d == 0)
+				continue;
+			Point* t = (j == 0) ? t1 : t2;
+			T = t[(d < 0 ? -d : d) >> 1];
+			if (d < 0)
+				T.y.ModNeg();
+			if (!assigned)
+			{
+				assigned = true;
+				r = T;
+			}
+			else
+			{
+				AddJ(r, T);
+			}
+		}
+	}
+
+	if (assigned)
+	{
+		Int zi(r.z);
+		Int zi2;
+		zi.ModInv();
+		zi2.ModSquareK1(zi);
+		r.x.ModMulK1(zi2);
+		r.y.ModMulK1(zi2);
+		r.y.ModMulK1(zi);
+		r.x.ModNormK1();
+		r.y.ModNormK1();
+		r.z.SetInt32(1);
+	}
+
+	return r;
+}
+
 Point Secp256K1::DivDirect(const Point& p, const Int& s)
 {
 	Point r;
@@ -18,7 +18,7 @@
 #ifndef SECP256K1H
 #define SECP256K1H
 
-#include "Point.h"
+#include "PointK1.h"
 #include <string>
 #include <vector>
 
@@ -27,11 +27,33 @@ const unsigned int P2PKH = 0;
 const unsigned int P2SH = 1;
 const unsigned int BECH32 = 2;
 
+// Hash backend (CPU)
+const int HASH_SCALAR = 0;
+const int HASH_SSE = 1;
+const int HASH_AVX2 = 2;
+const int HASH_AVX512 = 3;
+const int HASH_NB_BACKEND = 4;
+
+// Field arithmetic backend of the CPU group walk
+const int FIELD_SCALAR = 0;
+const int FIELD_AVX2 = 1;
+const int FIELD_IFMA = 2;
+const int FIELD_NB_BACKEND = 3;
+
+// Generator table window (bits), default and allowed range
+#define GTABLE_WINDOW 8
+#define GTABLE_WINDOW_MIN 4
+#define GTABLE_WINDOW_MAX 16
+
 class Secp256K1
 {
 public:
 	static void Init();
+	static void InitGTable(int window);
+	static void GenerateCode(int grpSize);
+	static uint32_t GetWindow(const Int& key, int i);
 	static Point ComputePublicKey(const Int& privKey);
+	static void ComputePublicKeyBatch(const Int* keys, Point* out, int n, const Point* offset = NULL, int nbThread = 1);
 	static Point NextKey(const Point& key);
 	static Point PrevKey(const Point& key);
 	static void Check();
@@ -43,6 +65,17 @@ public:
 	static bool CheckCalcPubKeyFull();
 	static bool CheckCalcPubKeyEven();
 	static bool CheckCalcPubKeyOdd();
+	static bool CheckMulGLV();
+	static void BenchMulGLV();
+	static bool CheckCalcPubKeyBatch();
+	static void BenchCalcPubKeyBatch();
+	static bool CheckHash160(int backend);
+	static bool CheckHash160Batch();
+	static void BenchHash160(int backend, int type, bool compressed);
+	static bool CheckSha256();
+	static void BenchSha256();
+	static bool CheckField(int backend);
+	static void BenchField(int backend);
 
 	static void PrintResult(bool ok);
 	static bool CheckAddress(const std::string& address, const std::string& privKeyStr);
@@ -51,7 +84,41 @@ public:
 
 	static void GetHash160(int type, bool compressed, const Point& k0, const Point& k1, const Point& k2, const Point& k3, uint8_t* h0, uint8_t* h1, uint8_t* h2, uint8_t* h3);
 
+	static void GetHash160(int type, bool compressed,
+		const Point& k0, const Point& k1, const Point& k2, const Point& k3,
+		const Point& k4, const Point& k5, const Point& k6, const Point& k7,
+		uint8_t* h0, uint8_t* h1, uint8_t* h2, uint8_t* h3,
+		uint8_t* h4, uint8_t* h5, uint8_t* h6, uint8_t* h7);
+
+	static void GetHash160x16(int type, bool compressed, const Point* k, uint8_t h[16][20]);
+
+	// Hash GetHashBackendWidth(backend) points with a SIMD backend, h[5][width] receives
+	// the lane-transposed hash160 (32 bits word w of point j at h[w * width + j])
+	static void GetHash160T(int backend, int type, bool compressed, const Point* k, uint32_t* h);
+	static void GetHash160T(int backend, int type, bool compressed, const PointK1* k, uint32_t* h);
+
+	// Same, specialized on the address type and the key format (search kernels)
+	template<int type, bool compressed>
+	static void GetHash160T(int backend, const PointK1* k, uint32_t* h);
+
 	static void GetHash160(int type, bool compressed, const Point& pubKey, unsigned char* hash);
+	static void GetHash160(int type, bool compressed, const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+	template<int type, bool compressed>
+	static void GetHash160(const Point& k0, const Point& k1, unsigned char* h0, unsigned char* h1);
+
+	// Hash n points using the widest supported kernel (narrower ones for the tail),
+	// out[i] receives the hash160 of pts[i]
+	static void GetHash160Batch(int type, bool compressed, const Point* pts, size_t n, uint8_t (*out)[20]);
+
+	static int GetHashBackend();						// Widest hash backend supported by the CPU
+	static bool IsHashBackendSupported(int backend);
+	static const char* GetHashBackendName(int backend);
+	static int GetHashBackendWidth(int backend);		// Number of points hashed per call
+
+	static int GetFieldBackend();						// Default field backend
+	static bool IsFieldBackendSupported(int backend);
+	static const char* GetFieldBackendName(int backend);
+	static int GetFieldBackendWidth(int backend);		// Number of points per AddGroupT call
 
 	static std::string GetAddress(int type, bool compressed, const Point& pubKey);
 	static std::string GetAddress(int type, bool compressed, unsigned char* hash160);
@@ -72,9 +139,18 @@ public:
 
 	static Point AddDirect(const Point& p1, const Point& p2);
 	static Point SubDirect(const Point& p1, const Point& p2);
+
+	// Group walk step on GetFieldBackendWidth(backend) points (1 for FIELD_SCALAR, lazy
+	// reduction): pp[j] = p + g[j] and pn[-j] = p - g[j], dx[j] must hold 1/(g[j].x - p.x)
+	static void AddGroupT(int backend, const Point& p, const PointK1* g, const IntK1* dx, PointK1* pp, PointK1* pn);
+	// Scalar group walk step of nbStream (1 to 4) independent groups sharing g, the steps
+	// of the streams are interleaved to hide the multiplication latency:
+	// *pp[s] = p[s] + g and *pn[s] = p[s] - g, *dx[s] must hold 1/(g.x - p[s].x)
+	static void AddGroupN(int nbStream, const Point* p, const PointK1& g, const IntK1* const* dx, PointK1* const* pp, PointK1* const* pn);
 	static Point DoubleDirect(const Point& p);
 	static Point HalveDirect(const Point& p);
 	static Point MulDirect(const Point& p, const Int& s);
+	static Point MulGLV(const Point& p, const Int& s);
 	static Point DivDirect(const Point& p, const Int& s);
 
 	
@@ -88,7 +164,9 @@ public:
 
 	static Point G;						// Generator point
 	static Point halfG;					// Half of generator point
-	static Point GTable[256 * 32];		// Generator table
+	static PointK1* GTable;				// Generator table (affine), window i entry j: (j+1).2^(window*i).G
+	static int gtableWindow;			// Window size (bits)
+	static int gtableNbWindow;			// Number of windows
 
 	static Int GetY(Int x, bool isEven);
 
@@ -164,12 +164,28 @@ int Timer::getCoreNumber() {
   GetSystemInfo(&sysinfo);
   return sysinfo.dwNumberOfProcessors;
 #else
-  // TODO
-  return 1;
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0) ? (int)n : 1;
 #endif
 
 }
 
+std::string Timer::getHostName() {
+
+  char name[256];
+#ifdef WIN64
+  DWORD size = sizeof(name);
+  if (!GetComputerNameA(name, &size))
+    return "localhost";
+#else
+  if (gethostname(name, sizeof(name)) != 0)
+    return "localhost";
+  name[sizeof(name) - 1] = 0;
+#endif
+  return std::string(name);
+
+}
+
 void Timer::SleepMillis(uint32_t millis) {
 
 #ifdef WIN64
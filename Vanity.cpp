@@ -21,25 +21,56 @@
 #include "hash/sha256.h"
 #include "hash/sha512.h"
 #include "IntGroup.h"
+#include "CPUGroup.h"
+#if CPUGROUP_GRP_SIZE != CPU_GRP_SIZE
+#error "CPUGroup.h was generated for another CPU_GRP_SIZE, rebuild it (make CPUGroup.h)"
+#endif
 #include "Wildcard.h"
 #include "Timer.h"
 #include "hash/ripemd160.h"
 #include <string.h>
 #include <math.h>
 #include <algorithm>
+#include <xmmintrin.h>
 #ifndef WIN64
 #include <pthread.h>
+#define _byteswap_uint64 __builtin_bswap64
 #endif
 
 using namespace std;
 
-Point Gn[CPU_GRP_SIZE / 2];
-Point _2Gn;
-
 // ----------------------------------------------------------------------------
 
+// Case variants of a prefix (letters after the first character)
+static uint64_t getNbCaseVariant(const string& s) {
+
+	int nbLetter = 0;
+	for (int i = 1; i < (int)s.length(); i++) {
+		char c = s[i];
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+			nbLetter++;
+	}
+	return 1ULL << nbLetter;
+
+}
+
+// Case variant i of s (bit j of i: upper case j-th letter), written in variant
+static void getCaseVariant(const string& s, uint64_t i, string& variant) {
+
+	variant.assign(s);
+	int j = 0;
+	for (int k = 1; k < (int)variant.length(); k++) {
+		char c = variant[k];
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+			variant[k] = ((i >> j) & 1) ? toupper(c) : tolower(c);
+			j++;
+		}
+	}
+
+}
+
 VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int searchMode,
-	bool useGpu, bool stop, string outputFile, bool useSSE, uint32_t maxFound,
+	bool useGpu, bool stop, string outputFile, int hashBackend, int fieldBackend, uint32_t maxFound,
 	uint64_t rekey, bool caseSensitive,const Point& startPubKey, bool paranoiacSeed, const Int& startKey)
 	:inputPrefixes(inputPrefixes) {
 
@@ -47,7 +78,12 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 	this->useGpu = useGpu;
 	this->stopWhenFound = stop;
 	this->outputFile = outputFile;
-	this->useSSE = useSSE;
+	this->hashBackend = hashBackend;
+	this->fieldBackend = fieldBackend;
+	this->tuning = false;
+	this->Gn = NULL;
+	this->GnBuff = NULL;
+	this->cpuStreams = 1;
 	this->nbGPUThread = 0;
 	this->maxFound = maxFound;
 	this->rekey = rekey;
@@ -66,14 +102,14 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 	}
 
 	lastRekey = 0;
-	prefixes.clear();
 
-	// Create a 65536 items lookup table
-	PREFIX_TABLE_ITEM t;
-	t.found = true;
-	t.items = NULL;
-	for (int i = 0; i < 65536; i++)
-		prefixes.push_back(t);
+	// Empty target store and lookup table
+	memset(&targets, 0, sizeof(targets));
+	targetArena = NULL;
+	memset(prefixBitmap, 0, sizeof(prefixBitmap));
+	prefixStart.assign(65536 + 1, 0);
+	filterProbe = 0;
+	filterPass = 0;
 
 	// Check is inputPrefixes contains wildcard character
 	for (int i = 0; i < (int)inputPrefixes.size() && !hasPattern; i++) {
@@ -89,90 +125,64 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 		if (loadingProgress)
 			printf("[Building lookup16   0.0%%]\r");
 
+		// Target store, sized for all the case variants, and the parsing buffers, sized
+		// for the longest input (no allocation per input)
+		uint64_t nbTargetMax = 0;
+		uint64_t poolSize = 0;
+		size_t maxLength = 0;
+		for (int i = 0; i < (int)inputPrefixes.size(); i++) {
+			uint64_t nbVariant = caseSensitive ? 1 : getNbCaseVariant(inputPrefixes[i]);
+			nbTargetMax += nbVariant;
+			poolSize += nbVariant * (inputPrefixes[i].length() + 1);
+			if (inputPrefixes[i].length() > maxLength)
+				maxLength = inputPrefixes[i].length();
+		}
+		allocTargets((uint32_t)inputPrefixes.size(), nbTargetMax, poolSize);
+		string variant;
+		variant.reserve(maxLength);
+		decodeBuffer.reserve(maxLength);
+
 		nbPrefix = 0;
 		onlyFull = true;
 		for (int i = 0; i < (int)inputPrefixes.size(); i++) {
 
 			PREFIX_ITEM it;
-			std::vector<PREFIX_ITEM> itPrefixes;
+			double p = 0.0;
+			uint32_t nbTarget = targets.nbTarget;
 
 			if (!caseSensitive) {
 
 				// For caseunsensitive search, loop through all possible combination
 				// and fill up lookup table
-				vector<string> subList;
-				enumCaseUnsentivePrefix(inputPrefixes[i], subList);
-
-				bool* found = new bool;
-				*found = false;
-
-				for (int j = 0; j < (int)subList.size(); j++) {
-					if (initPrefix(subList[j], &it)) {
-						it.found = found;
-						it.prefix = strdup(it.prefix); // We need to allocate here, subList will be destroyed
-						itPrefixes.push_back(it);
-					}
-				}
-
-				if (itPrefixes.size() > 0) {
-
-					// Compute difficulty for case unsensitive search
-					// Not obvious to perform the right calculation here using standard double
-					// Improvement are welcome
-
-					// Get the min difficulty and divide by the number of item having the same difficulty
-					// Should give good result when difficulty is large enough
-					double dMin = itPrefixes[0].difficulty;
-					int nbMin = 1;
-					for (int j = 1; j < (int)itPrefixes.size(); j++) {
-						if (itPrefixes[j].difficulty == dMin) {
-							nbMin++;
-						}
-						else if (itPrefixes[j].difficulty < dMin) {
-							dMin = itPrefixes[j].difficulty;
-							nbMin = 1;
-						}
+				uint64_t nbVariant = getNbCaseVariant(inputPrefixes[i]);
+
+				for (uint64_t j = 0; j < nbVariant; j++) {
+					getCaseVariant(inputPrefixes[i], j, variant);
+					if (initPrefix(variant, &it)) {
+						addTarget(i, it);
+						// The variants have the same length, their hash160 ranges are disjoint
+						p += 1.0 / it.difficulty;
 					}
-
-					dMin /= (double)nbMin;
-
-					// Updates
-					for (int j = 0; j < (int)itPrefixes.size(); j++)
-						itPrefixes[j].difficulty = dMin;
-
 				}
 
 			}
 			else {
 
 				if (initPrefix(inputPrefixes[i], &it)) {
-					bool* found = new bool;
-					*found = false;
-					it.found = found;
-					itPrefixes.push_back(it);
+					addTarget(i, it);
+					p = 1.0 / it.difficulty;
 				}
 
 			}
 
-			if (itPrefixes.size() > 0) {
-
-				// Add the item to all correspoding prefixes in the lookup table
-				for (int j = 0; j < (int)itPrefixes.size(); j++) {
-
-					prefix_t p = itPrefixes[j].sPrefix;
-
-					if (prefixes[p].items == NULL) {
-						prefixes[p].items = new vector<PREFIX_ITEM>();
-						prefixes[p].found = false;
-						usedPrefix.push_back(p);
-					}
-					(*prefixes[p].items).push_back(itPrefixes[j]);
-
-				}
-
+			if (targets.nbTarget > nbTarget) {
+				targets.difficulty[i] = 1.0 / p;
 				onlyFull &= it.isFull;
 				nbPrefix++;
-
+			}
+			else {
+				// Nothing to search
+				setFound(i);
 			}
 
 			if (loadingProgress && i % 1000 == 0)
@@ -194,27 +204,75 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 			exit(1);
 		}
 
-		// Second level lookup
+		// Group the items per prefix (counting sort, target order kept), addTarget()
+		// has counted them in prefixStart[p + 1]
+		uint32_t nbUsed = 0;
+		for (int p = 0; p < 65536; p++)
+			if (prefixStart[p + 1] > 0)
+				nbUsed++;
+		usedPrefix.reserve(nbUsed);
+		for (int p = 0; p < 65536; p++) {
+			if (prefixStart[p + 1] > 0) {
+				prefixBitmap[p >> 6] |= 1ULL << (p & 63);
+				usedPrefix.push_back((prefix_t)p);
+			}
+			prefixStart[p + 1] += prefixStart[p];
+		}
+		lookupItems.resize(prefixStart[65536]);
+		std::vector<uint32_t> fill(prefixStart.begin(), prefixStart.end() - 1);
+		for (uint32_t t = 0; t < targets.nbTarget; t++) {
+
+			if (searchMode == SEARCH_PUBLICKEYS) {
+				prefix_t p = *(prefix_t*)&targets.pubkey[t].x.bits16[NB16BLOCK - 5];
+				LOOKUP_ITEM& li = lookupItems[fill[p]++];
+				li.min64 = 0;
+				li.max64 = 0xFFFFFFFFFFFFFFFFULL;
+				li.target = t;
+				continue;
+			}
+
+			// The 16 bit prefixes covered by the hash160 ranges
+			for (uint32_t r = targets.range[t]; r < targets.range[t + 1]; r++) {
+				uint64_t min64 = targets.rangeMin[r];
+				uint64_t max64 = targets.rangeMax[r];
+				for (uint32_t b = (uint32_t)(min64 >> 48); b <= (uint32_t)(max64 >> 48); b++) {
+					// Little endian read of the 2 first hash160 bytes
+					prefix_t p = (prefix_t)((b >> 8) | ((b & 0xFF) << 8));
+					LOOKUP_ITEM& li = lookupItems[fill[p]++];
+					li.min64 = min64;
+					li.max64 = max64;
+					li.target = t;
+				}
+			}
+
+		}
+
+		// Filter of the hash160 ranges (addresses only)
+		if (searchMode != SEARCH_PUBLICKEYS)
+			filter.Build(targets.rangeMin, targets.rangeMax, targets.range[targets.nbTarget],
+				(double)usedPrefix.size() / 65536.0, (double)lookupItems.size() / (double)usedPrefix.size());
+
+		// Second level lookup (GPU, full addresses), lPrefix: first 4 bytes of the hash160
 		uint32_t unique_sPrefix = 0;
 		uint32_t minI = 0xFFFFFFFF;
 		uint32_t maxI = 0;
-		for (int i = 0; i < (int)prefixes.size(); i++) {
-			if (prefixes[i].items) {
+		for (int i = 0; i < (int)usedPrefix.size(); i++) {
+			prefix_t p = usedPrefix[i];
+			uint32_t nbItem = prefixStart[p + 1] - prefixStart[p];
+			if (useGpu && onlyFull) {
 				LPREFIX lit;
-				lit.sPrefix = i;
-				if (prefixes[i].items) {
-					for (int j = 0; j < (int)prefixes[i].items->size(); j++) {
-						lit.lPrefixes.push_back((*prefixes[i].items)[j].lPrefix);
-					}
+				lit.sPrefix = p;
+				for (uint32_t j = prefixStart[p]; j < prefixStart[p + 1]; j++) {
+					lit.lPrefixes.push_back((prefixl_t)_byteswap_uint64(lookupItems[j].min64));
 				}
 				sort(lit.lPrefixes.begin(), lit.lPrefixes.end());
 				usedPrefixL.push_back(lit);
-				if ((uint32_t)lit.lPrefixes.size() > maxI) maxI = (uint32_t)lit.lPrefixes.size();
-				if ((uint32_t)lit.lPrefixes.size() < minI) minI = (uint32_t)lit.lPrefixes.size();
-				unique_sPrefix++;
 			}
-			if (loadingProgress)
-				printf("[Building lookup32 %.1f%%]\r", ((double)i * 100.0) / (double)prefixes.size());
+			if (nbItem > maxI) maxI = nbItem;
+			if (nbItem < minI) minI = nbItem;
+			unique_sPrefix++;
+			if (loadingProgress && i % 1000 == 0)
+				printf("[Building lookup32 %.1f%%]\r", ((double)i * 100.0) / (double)usedPrefix.size());
 		}
 
 		if (loadingProgress)
@@ -241,6 +299,8 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 				printf("Search: %d prefixes (Lookup size %d) [%s]\n", nbPrefix, unique_sPrefix, seachInfo.c_str());
 			}
 		}
+		if (filter.GetType() != FILTER_NONE)
+			printf("Filter: %s\n", filter.GetInfo().c_str());
 
 	}
 	else {
@@ -279,18 +339,7 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 	}
 
 
-	// Compute Generator table G[n] = (n+1)*G
-
-	Point g = Secp256K1::G;
-	Gn[0] = g;
-	g = Secp256K1::DoubleDirect(g);
-	Gn[1] = g;
-	for (int i = 2; i < CPU_GRP_SIZE / 2; i++) {
-		g = Secp256K1::AddDirect(g, Secp256K1::G);
-		Gn[i] = g;
-	}
-	// _2Gn = CPU_GRP_SIZE*G
-	_2Gn = Secp256K1::DoubleDirect(Gn[CPU_GRP_SIZE / 2 - 1]);
+	InitCPUGroup(CPU_GRP_SIZE);
 
 	// Constant for endomorphism
 	// if a is a nth primitive root of unity, a^-1 is also a nth primitive root.
@@ -340,7 +389,7 @@ VanitySearch::VanitySearch(vector<std::string>& inputPrefixes, string seed, int
 
 // ----------------------------------------------------------------------------
 
-bool VanitySearch::isSingularPrefix(std::string pref) {
+bool VanitySearch::isSingularPrefix(const std::string& pref) {
 
 	// check is the given prefix contains only 1
 	bool only1 = true;
@@ -353,12 +402,136 @@ bool VanitySearch::isSingularPrefix(std::string pref) {
 
 }
 
+// ----------------------------------------------------------------------------
+// Hash160 ranges of the address prefixes
+
+static double getDouble(const Int& a) {
+
+	double r = 0.0;
+	for (int i = NB64BLOCK - 1; i >= 0; i--)
+		r = r * 18446744073709551616.0 + (double)a.bits64[i];
+	return r;
+
+}
+
+static void setRangeBound(const Int& h, uint8_t* b, uint64_t* b64) {
+
+	unsigned char buff[32];
+	h.Get32Bytes(buff);
+	memcpy(b, buff + 12, 20);
+	*b64 = _byteswap_uint64(*(uint64_t*)b);
+
+}
+
+// Adds [hMin,hMax] (hash160 as integers) to the ranges of it
+static void addRange(PREFIX_ITEM* it, const Int& hMin, const Int& hMax) {
+
+	HASH160_RANGE* r = it->range + it->nbRange;
+	setRangeBound(hMin, r->min, &r->min64);
+	setRangeBound(hMax, r->max, &r->max64);
+	it->nbRange++;
+
+}
+
+// Ranges of the hash160 whose address (base58 of version, hash160 and checksum)
+// starts with prefix, returns the probability of a random hash160 to match.
+// Leading '1' are leading zero bytes, the remaining digits fix the base58 encoded
+// number to one interval per address length. The bounds are rounded outwards to
+// whole hash160 (checksum ignored), a range hit is confirmed on the address.
+static double getBase58Ranges(const string& prefix, int version, vector<unsigned char>& digits, PREFIX_ITEM* it) {
+
+	Int base;
+	Int nLo;
+	Int nHi;
+	Int lo;
+	Int hi;
+	Int a;
+	Int b;
+	Int d;
+	Int hMin;
+	Int hMax;
+	double p = 0.0;
+
+	it->nbRange = 0;
+
+	// Number of zero bytes at the start of the hash160
+	int k = 0;
+	while (k < (int)prefix.length() && prefix[k] == '1')
+		k++;
+	int z = (version == 0) ? k - 1 : k;
+	if (z < 0 || (version != 0 && k > 0) || z >= 20)
+		return 0.0;
+
+	// Encoded number X = base + N, N = hash160|checksum in [nLo,nHi)
+	base.SetInt32(version);
+	base.ShiftL(192);
+	nHi.SetInt32(1);
+	nHi.ShiftL(192 - 8 * z);
+
+	if (k == (int)prefix.length()) {
+
+		// Only '1': at least z zero bytes
+		hMin.SetInt32(0);
+		hMax.Set(nHi);
+		hMax.ShiftR(32);
+		hMax.SubOne();
+		addRange(it, hMin, hMax);
+		return pow(2.0, -8.0 * z);
+
+	}
+
+	// Exactly z zero bytes (P2PKH)
+	if (version == 0) {
+		nLo.SetInt32(1);
+		nLo.ShiftL(184 - 8 * z);
+	}
+	else {
+		nLo.SetInt32(0);
+	}
+	nLo.Add(base);
+	nHi.Add(base);
+
+	if (!DecodeBase58(prefix.c_str() + k, digits))
+		return 0.0;
+	lo.SetInt32(0);
+	for (int i = 0; i < (int)digits.size(); i++) {
+		lo.ShiftL(8);
+		lo.Add((uint64_t)digits[i]);
+	}
+	hi.Set(lo);
+	hi.AddOne();
+
+	// [lo,hi) = X starting with the digits, one more digit per loop
+	while (lo.IsLower(nHi) && it->nbRange < PREFIX_RANGE_MAX) {
+
+		a.Set(lo.IsGreater(nLo) ? lo : nLo);
+		b.Set(hi.IsLower(nHi) ? hi : nHi);
+
+		if (a.IsLower(b)) {
+			d.Set(b);
+			d.Sub(a);
+			p += getDouble(d) / pow(2.0, 192);
+			a.Sub(base);
+			b.Sub(base);
+			b.SubOne();
+			a.ShiftR(32);
+			b.ShiftR(32);
+			addRange(it, a, b);
+		}
+
+		lo.Mult((uint64_t)58);
+		hi.Mult((uint64_t)58);
+
+	}
+
+	return p;
+
+}
+
 // ----------------------------------------------------------------------------
 bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 
-	std::vector<unsigned char> result;
-	string dummy1 = prefix;
-	int nbDigit = 0;
+	std::vector<unsigned char>& result = decodeBuffer;
 	bool wrong = false;
 
 	if (prefix.length() < 2) {
@@ -367,6 +540,9 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 	}
 
 	int aType = -1;
+	Int h;
+	Int hMax;
+	unsigned char hb[32];
 
 
 	if (searchMode == SEARCH_PUBLICKEYS) {
@@ -393,8 +569,11 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 		}
 		else
 		{
-			pt.x.SetBase16((char*)prefix.substr(0, 64).c_str());
-			pt.y.SetBase16((char*)prefix.substr(64).c_str());
+			char x[65];
+			memcpy(x, prefix.c_str(), 64);
+			x[64] = 0;
+			pt.x.SetBase16(x);
+			pt.y.SetBase16((char*)prefix.c_str() + 64);
 			pt.y.ShiftL((64 - (prefix.size() - 64)) * 4);
 		}	
 
@@ -407,6 +586,7 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 
 		it->pubkeylen = prefix.size() / 2;
 		it->pubkey = pt;
+		it->nbRange = 0;
 
 		return true;
 	}
@@ -458,6 +638,11 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 				it->lPrefix = *(prefixl_t*)(it->hash160);
 				it->prefix = (char*)prefix.c_str();
 				it->prefixLength = (int)prefix.length();
+				memset(hb, 0, 12);
+				memcpy(hb + 12, it->hash160, 20);
+				h.Set32Bytes(hb);
+				it->nbRange = 0;
+				addRange(it, h, h);
 				return true;
 
 			}
@@ -480,9 +665,21 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 				return false;
 			}
 
+			// The 5*(length-4) first bits of the hash160 are fixed
+			int nbBit = 5 * ((int)prefix.length() - 4);
+			memset(hb, 0, 12);
+			memcpy(hb + 12, data, 20);
+			h.Set32Bytes(hb);
+			hMax.SetInt32(1);
+			hMax.ShiftL(160 - nbBit);
+			hMax.SubOne();
+			hMax.Add(h);
+			it->nbRange = 0;
+			addRange(it, h, hMax);
+
 			// Difficulty
 			it->sPrefix = *(prefix_t*)data;
-			it->difficulty = pow(2, 5 * (prefix.length() - 4));
+			it->difficulty = pow(2, nbBit);
 			it->isFull = false;
 			it->lPrefix = 0;
 			it->prefix = (char*)prefix.c_str();
@@ -517,67 +714,37 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 				it->lPrefix = *(prefixl_t*)(it->hash160);
 				it->prefix = (char*)prefix.c_str();
 				it->prefixLength = (int)prefix.length();
+				memset(hb, 0, 12);
+				memcpy(hb + 12, it->hash160, 20);
+				h.Set32Bytes(hb);
+				it->nbRange = 0;
+				addRange(it, h, h);
 				return true;
 
 			}
 
 			// Prefix containing only '1'
-			if (isSingularPrefix(prefix)) {
-
-				if (prefix.length() > 21) {
-					printf("Ignoring prefix \"%s\" (Too much 1)\n", prefix.c_str());
-					return false;
-				}
-
-				// Difficulty
-				it->difficulty = pow(256, prefix.length() - 1);
-				it->isFull = false;
-				it->sPrefix = 0;
-				it->lPrefix = 0;
-				it->prefix = (char*)prefix.c_str();
-				it->prefixLength = (int)prefix.length();
-				return true;
-
-			}
-
-			// Search for highest hash160 16bit prefix (most probable)
-
-			while (result.size() < 25) {
-				DecodeBase58(dummy1, result);
-				if (result.size() < 25) {
-					dummy1.append("1");
-					nbDigit++;
-				}
+			if (isSingularPrefix(prefix) && prefix.length() > 21) {
+				printf("Ignoring prefix \"%s\" (Too much 1)\n", prefix.c_str());
+				return false;
 			}
 
-			if (searchType == P2SH) {
-				if (result.data()[0] != 5) {
-					if (caseSensitive)
+			// Hash160 ranges of the prefix
+			double p = getBase58Ranges(prefix, (searchType == P2SH) ? 5 : 0, decodeBuffer, it);
+			if (it->nbRange == 0) {
+				if (caseSensitive) {
+					if (searchType == P2SH)
 						printf("Ignoring prefix \"%s\" (Unreachable, 31h1 to 3R2c only)\n", prefix.c_str());
-					return false;
+					else
+						printf("Ignoring prefix \"%s\" (Unreachable)\n", prefix.c_str());
 				}
-			}
-
-			if (result.size() != 25) {
-				printf("Ignoring prefix \"%s\" (Invalid size)\n", prefix.c_str());
 				return false;
 			}
 
-			//printf("VanitySearch: Found prefix %s\n",GetHex(result).c_str() );
-			it->sPrefix = *(prefix_t*)(result.data() + 1);
-
-			dummy1.append("1");
-			DecodeBase58(dummy1, result);
-
-			if (result.size() == 25) {
-				//printf("VanitySearch: Found prefix %s\n", GetHex(result).c_str());
-				it->sPrefix = *(prefix_t*)(result.data() + 1);
-				nbDigit++;
-			}
-
 			// Difficulty
-			it->difficulty = pow(2, 192) / pow(58, nbDigit);
+			it->difficulty = 1.0 / p;
 			it->isFull = false;
+			it->sPrefix = *(prefix_t*)(it->range[0].min);
 			it->lPrefix = 0;
 			it->prefix = (char*)prefix.c_str();
 			it->prefixLength = (int)prefix.length();
@@ -589,58 +756,122 @@ bool VanitySearch::initPrefix(std::string& prefix, PREFIX_ITEM* it) {
 }
 
 // ----------------------------------------------------------------------------
+// Target store
 
-void VanitySearch::dumpPrefixes() {
+// Carves size bytes (8 bytes aligned) at offset from arena, or only counts them
+// when arena is NULL
+static void* arenaGet(uint8_t* arena, uint64_t& offset, uint64_t size) {
+
+	void* p = (arena != NULL) ? arena + offset : NULL;
+	offset += (size + 7) & ~7ULL;
+	return p;
 
-	for (int i = 0; i < 0xFFFF; i++) {
-		if (prefixes[i].items) {
-			printf("%04X\n", i);
-			for (int j = 0; j < (int)prefixes[i].items->size(); j++) {
-				printf("  %d\n", (*prefixes[i].items)[j].sPrefix);
-				printf("  %g\n", (*prefixes[i].items)[j].difficulty);
-				printf("  %s\n", (*prefixes[i].items)[j].prefix);
+}
+
+void VanitySearch::allocTargets(uint32_t nbInput, uint64_t nbTarget, uint64_t poolSize) {
+
+	bool pubKeys = (searchMode == SEARCH_PUBLICKEYS);
+	uint64_t nbRange = pubKeys ? 0 : nbTarget * PREFIX_RANGE_MAX;
+	uint64_t nbRangeIndex = pubKeys ? 0 : nbTarget + 1;
+	uint64_t nbPubKey = pubKeys ? nbTarget : 0;
+	uint64_t size = 0;
+	uint8_t* arena = NULL;
+
+	// First pass counts the arena size
+	for (int pass = 0; pass < 2; pass++) {
+
+		uint64_t offset = 0;
+		targets.found = (uint64_t*)arenaGet(arena, offset, ((nbInput + 63) / 64) * 8);
+		targets.difficulty = (double*)arenaGet(arena, offset, nbInput * sizeof(double));
+		targets.rangeMin = (uint64_t*)arenaGet(arena, offset, nbRange * 8);
+		targets.rangeMax = (uint64_t*)arenaGet(arena, offset, nbRange * 8);
+		targets.pubkey = (Point*)arenaGet(arena, offset, nbPubKey * sizeof(Point));
+		targets.input = (uint32_t*)arenaGet(arena, offset, nbTarget * 4);
+		targets.prefix = (uint32_t*)arenaGet(arena, offset, nbTarget * 4);
+		targets.prefixLength = (uint8_t*)arenaGet(arena, offset, nbTarget);
+		targets.range = (uint32_t*)arenaGet(arena, offset, nbRangeIndex * 4);
+		targets.pubkeyLength = (uint8_t*)arenaGet(arena, offset, nbPubKey);
+		targets.pool = (char*)arenaGet(arena, offset, poolSize);
+
+		if (pass == 0) {
+			size = offset;
+			arena = (uint8_t*)malloc(size);
+			if (arena == NULL) {
+				printf("VanitySearch: Failed to allocate %.1f MB for the targets\n", (double)size / 1048576.0);
+				exit(1);
 			}
 		}
+
 	}
 
+	// Found bits and difficulties, the rest is written by addTarget()
+	memset(arena, 0, ((nbInput + 63) / 64) * 8 + nbInput * sizeof(double));
+	targets.nbTarget = 0;
+	if (!pubKeys)
+		targets.range[0] = 0;
+	targetArena = arena;
+
 }
-// ----------------------------------------------------------------------------
 
-void VanitySearch::enumCaseUnsentivePrefix(std::string s, std::vector<std::string>& list) {
+// Stores a parsed target and counts its items in prefixStart[p + 1] (p: 16 bit prefix)
+void VanitySearch::addTarget(uint32_t input, const PREFIX_ITEM& it) {
 
-	char letter[64];
-	int letterpos[64];
-	int nbLetter = 0;
-	int length = (int)s.length();
+	uint32_t t = targets.nbTarget++;
+	uint32_t poolOffset = (t == 0) ? 0 : targets.prefix[t - 1] + targets.prefixLength[t - 1] + 1;
 
-	for (int i = 1; i < length; i++) {
-		char c = s.data()[i];
-		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-			letter[nbLetter] = tolower(c);
-			letterpos[nbLetter] = i;
-			nbLetter++;
-		}
+	targets.input[t] = input;
+	targets.prefix[t] = poolOffset;
+	targets.prefixLength[t] = (uint8_t)it.prefixLength;
+	memcpy(targets.pool + poolOffset, it.prefix, it.prefixLength);
+	targets.pool[poolOffset + it.prefixLength] = 0;
+
+	if (searchMode == SEARCH_PUBLICKEYS) {
+		targets.pubkey[t] = it.pubkey;
+		targets.pubkeyLength[t] = (uint8_t)it.pubkeylen;
+		prefixStart[it.sPrefix + 1]++;
+		return;
+	}
+
+	uint32_t r0 = targets.range[t];
+	targets.range[t + 1] = r0 + it.nbRange;
+	for (int r = 0; r < it.nbRange; r++) {
+		uint64_t min64 = it.range[r].min64;
+		uint64_t max64 = it.range[r].max64;
+		targets.rangeMin[r0 + r] = min64;
+		targets.rangeMax[r0 + r] = max64;
+		for (uint32_t b = (uint32_t)(min64 >> 48); b <= (uint32_t)(max64 >> 48); b++)
+			prefixStart[((b >> 8) | ((b & 0xFF) << 8)) + 1]++;
 	}
 
-	int total = 1 << nbLetter;
+}
 
-	for (int i = 0; i < total; i++) {
+// Concurrent threads may find prefixes sharing the same bitset word
+void VanitySearch::setFound(uint32_t input) {
 
-		char tmp[64];
-		strcpy(tmp, s.c_str());
+#ifdef WIN64
+	_InterlockedOr64((volatile int64_t*)&targets.found[input >> 6], (int64_t)(1ULL << (input & 63)));
+#else
+	__sync_fetch_and_or(&targets.found[input >> 6], 1ULL << (input & 63));
+#endif
 
-		for (int j = 0; j < nbLetter; j++) {
-			int mask = 1 << j;
-			if (mask & i) tmp[letterpos[j]] = toupper(letter[j]);
-			else         tmp[letterpos[j]] = letter[j];
-		}
+}
+
+// ----------------------------------------------------------------------------
 
-		list.push_back(string(tmp));
+void VanitySearch::dumpPrefixes() {
 
+	for (int i = 0; i < (int)usedPrefix.size(); i++) {
+		prefix_t p = usedPrefix[i];
+		printf("%04X\n", p);
+		for (uint32_t j = prefixStart[p]; j < prefixStart[p + 1]; j++) {
+			uint32_t t = lookupItems[j].target;
+			printf("  %016llX-%016llX\n", (unsigned long long)lookupItems[j].min64, (unsigned long long)lookupItems[j].max64);
+			printf("  %g\n", targets.difficulty[targets.input[t]]);
+			printf("  %s\n", targets.pool + targets.prefix[t]);
+		}
 	}
 
 }
-
 // ----------------------------------------------------------------------------
 
 double VanitySearch::getDiffuclty() {
@@ -650,15 +881,10 @@ double VanitySearch::getDiffuclty() {
 	if (onlyFull)
 		return min;
 
-	for (int i = 0; i < (int)usedPrefix.size(); i++) {
-		int p = usedPrefix[i];
-		if (prefixes[p].items) {
-			for (int j = 0; j < (int)prefixes[p].items->size(); j++) {
-				if (!*((*prefixes[p].items)[j].found)) {
-					if ((*prefixes[p].items)[j].difficulty < min)
-						min = (*prefixes[p].items)[j].difficulty;
-				}
-			}
+	for (uint32_t i = 0; i < (uint32_t)inputPrefixes.size(); i++) {
+		if (!isFound(i)) {
+			if (targets.difficulty[i] < min)
+				min = targets.difficulty[i];
 		}
 	}
 
@@ -816,20 +1042,13 @@ void VanitySearch::updateFound() {
 		}
 		else {
 
+			// Inputs with nothing to search are marked as found
 			bool allFound = true;
-			for (int i = 0; i < (int)usedPrefix.size(); i++) {
-				bool iFound = true;
-				prefix_t p = usedPrefix[i];
-				if (!prefixes[p].found) {
-					if (prefixes[p].items) {
-						for (int j = 0; j < (int)prefixes[p].items->size(); j++) {
-							iFound &= *((*prefixes[p].items)[j].found);
-						}
-					}
-					prefixes[usedPrefix[i]].found = iFound;
-				}
-				allFound &= iFound;
-			}
+			uint32_t nbInput = (uint32_t)inputPrefixes.size();
+			for (uint32_t i = 0; i < nbInput / 64 && allFound; i++)
+				allFound = (targets.found[i] == 0xFFFFFFFFFFFFFFFFULL);
+			for (uint32_t i = nbInput & ~63U; i < nbInput && allFound; i++)
+				allFound = isFound(i);
 			endOfSearch = allFound;
 
 			// Update difficulty to the next most probable item
@@ -904,7 +1123,10 @@ bool VanitySearch::checkPrivKey(string addr, const Int& key, int32_t incr, int e
 
 void VanitySearch::checkAddrSSE(uint8_t* h1, uint8_t* h2, uint8_t* h3, uint8_t* h4,
 	int32_t incr1, int32_t incr2, int32_t incr3, int32_t incr4,
-	Int& key, int endomorphism, bool mode) {
+	const Int& key, int endomorphism, bool mode) {
+
+	if (tuning)
+		return;
 
 	vector<string> addr = Secp256K1::GetAddress(searchType, mode, h1, h2, h3, h4);
 
@@ -988,10 +1210,13 @@ bool pubKeyCompare(const Point& pt1, const Point& pt2, int len)
 
 void VanitySearch::checkPubKey(int pi, const Int& key, int32_t incr, int endomorphism, const Point& pt) {
 
-	for (int i = 0; i < prefixes[pi].items->size(); ++i)
+	if (tuning)
+		return;
+
+	for (uint32_t i = prefixStart[pi]; i < prefixStart[pi + 1]; ++i)
 	{
-		PREFIX_ITEM* preitm = &(*prefixes[pi].items)[i];
-		if(pubKeyCompare(pt, preitm->pubkey, preitm->pubkeylen))
+		uint32_t t = lookupItems[i].target;
+		if(pubKeyCompare(pt, targets.pubkey[t], targets.pubkeyLength[t]))
 		{
 			if (checkPrivKey(Secp256K1::GetAddress(P2PKH, false, pt), key, incr, endomorphism, false))
 			{
@@ -1002,9 +1227,45 @@ void VanitySearch::checkPubKey(int pi, const Int& key, int32_t incr, int endomor
 	}	
 }
 
-void VanitySearch::checkAddr(int prefIdx, uint8_t* hash160, Int& key, int32_t incr, int endomorphism, bool mode) {
+// Candidate for checkAddr(): 16 bit lookup hit, then filter hit
+inline bool VanitySearch::isCandidate(prefix_t p, const uint8_t* hash160, uint32_t* stat) {
+
+	if (!hasPrefix(p))
+		return false;
+	if (filter.GetType() == FILTER_NONE)
+		return true;
+	stat[0]++;
+	if (!filter.Check(_byteswap_uint64(*(uint64_t*)hash160)))
+		return false;
+	stat[1]++;
+	return true;
+
+}
+
+// Once per batch, shared by the CPU threads
+void VanitySearch::addFilterStat(const uint32_t* stat) {
 
-	if (hasPattern) {
+	if (stat[0]) {
+#ifdef WIN64
+		_InterlockedExchangeAdd64((volatile int64_t*)&filterProbe, (int64_t)stat[0]);
+		_InterlockedExchangeAdd64((volatile int64_t*)&filterPass, (int64_t)stat[1]);
+#else
+		__sync_fetch_and_add(&filterProbe, (uint64_t)stat[0]);
+		__sync_fetch_and_add(&filterPass, (uint64_t)stat[1]);
+#endif
+	}
+
+}
+
+// The address type and key format only matter on a hit, the matcher is resolved at compile time
+template<int matcher>
+void VanitySearch::checkAddr(int prefIdx, uint8_t* hash160, const Int& key, int32_t incr, int endomorphism, bool mode) {
+
+	// Autotune trials only measure the search rate
+	if (tuning)
+		return;
+
+	if (matcher == MATCH_PATTERN) {
 
 		// Wildcard search
 		string addr = Secp256K1::GetAddress(searchType, mode, hash160);
@@ -1029,60 +1290,48 @@ void VanitySearch::checkAddr(int prefIdx, uint8_t* hash160, Int& key, int32_t in
 
 	}
 
-	vector<PREFIX_ITEM>* pi = prefixes[prefIdx].items;
+	// Hash160 ranges, the address is encoded on range hits only. The range bounds are
+	// rounded to 64 bits (and may match part of the checksums only), the address
+	// compare is exact: a full address is its own prefix.
+	const LOOKUP_ITEM* li = &lookupItems[prefixStart[prefIdx]];
+	int nbItem = (int)(prefixStart[prefIdx + 1] - prefixStart[prefIdx]);
+	uint64_t h64 = _byteswap_uint64(*(uint64_t*)hash160);
+	string addr;
 
-	if (onlyFull) {
+	for (int i = 0; i < nbItem; i++) {
 
-		// Full addresses
-		for (int i = 0; i < (int)pi->size(); i++) {
+		if (h64 < li[i].min64 || h64 > li[i].max64)
+			continue;
 
-			if (stopWhenFound && *((*pi)[i].found))
-				continue;
+		uint32_t t = li[i].target;
+		if (stopWhenFound && isFound(targets.input[t]))
+			continue;
 
-			if (ripemd160_comp_hash((*pi)[i].hash160, hash160)) {
+		if (addr.length() == 0)
+			addr = Secp256K1::GetAddress(searchType, mode, hash160);
 
-				// Found it !
-				*((*pi)[i].found) = true;
-				// You believe it ?
-				if (checkPrivKey(Secp256K1::GetAddress(searchType, mode, hash160), key, incr, endomorphism, mode)) {
-					nbFoundKey++;
-					updateFound();
-				}
+		if (strncmp(addr.c_str(), targets.pool + targets.prefix[t], targets.prefixLength[t]) == 0) {
 
+			// Found it !
+			setFound(targets.input[t]);
+			if (checkPrivKey(addr, key, incr, endomorphism, mode)) {
+				nbFoundKey++;
+				updateFound();
 			}
 
 		}
 
 	}
-	else {
-
-
-		char a[64];
-
-		string addr = Secp256K1::GetAddress(searchType, mode, hash160);
-
-		for (int i = 0; i < (int)pi->size(); i++) {
 
-			if (stopWhenFound && *((*pi)[i].found))
-				continue;
-
-			strncpy(a, addr.c_str(), (*pi)[i].prefixLength);
-			a[(*pi)[i].prefixLength] = 0;
-
-			if (strcmp((*pi)[i].prefix, a) == 0) {
-
-				// Found it !
-				*((*pi)[i].found) = true;
-				if (checkPrivKey(addr, key, incr, endomorphism, mode)) {
-					nbFoundKey++;
-					updateFound();
-				}
-
-			}
+}
 
-		}
+// GPU items, the matcher is selected at run time
+void VanitySearch::checkAddr(int prefIdx, uint8_t* hash160, const Int& key, int32_t incr, int endomorphism, bool mode) {
 
-	}
+	if (hasPattern)
+		checkAddr<MATCH_PATTERN>(prefIdx, hash160, key, incr, endomorphism, mode);
+	else
+		checkAddr<MATCH_PREFIX>(prefIdx, hash160, key, incr, endomorphism, mode);
 
 }
 
@@ -1110,299 +1359,319 @@ void* _FindKeyGPU(void* lpParam) {
 
 // ----------------------------------------------------------------------------
 
-void VanitySearch::checkAddresses(bool compressed, Int key, int i, Point p1) {
+template<int type, bool compressed, int matcher>
+void VanitySearch::checkAddresses(const Int& key, int i, const Point& p1) {
 
 	unsigned char h0[20];
+	unsigned char h1[20];
 	Point pte1[1];
 	Point pte2[1];
+	Point ps;
+	uint32_t stat[2] = { 0, 0 };
 
-	// Point
-	Secp256K1::GetHash160(searchType, compressed, p1, h0);
-	prefix_t pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, i, 0, compressed);
+	// Hashes are computed 2 by 2 (interleaved SHA-NI when available)
+	// Pattern search has no prefix table: every address is matched
 
-	// Endomorphism #1
+	// Point and Endomorphism #1
 	pte1[0].x.ModMulK1(p1.x, beta);
 	pte1[0].y.Set(p1.y);
 
-	Secp256K1::GetHash160(searchType, compressed, pte1[0], h0);
+	Secp256K1::GetHash160<type, compressed>(p1, pte1[0], h0, h1);
 
-	pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, i, 1, compressed);
+	prefix_t pr0 = *(prefix_t*)h0;
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h0, stat))
+		checkAddr<matcher>(pr0, h0, key, i, 0, compressed);
+	pr0 = *(prefix_t*)h1;
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h1, stat))
+		checkAddr<matcher>(pr0, h1, key, i, 1, compressed);
 
-	// Endomorphism #2
+	// Endomorphism #2 and Curve symetrie
+	// if (x,y) = k*G, then (x, -y) is -k*G
 	pte2[0].x.ModMulK1(p1.x, beta2);
 	pte2[0].y.Set(p1.y);
+	ps.x.Set(p1.x);
+	ps.y.Set(p1.y);
+	ps.y.ModNeg();
 
-	Secp256K1::GetHash160(searchType, compressed, pte2[0], h0);
-
-	pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, i, 2, compressed);
+	Secp256K1::GetHash160<type, compressed>(pte2[0], ps, h0, h1);
 
-	// Curve symetrie
-	// if (x,y) = k*G, then (x, -y) is -k*G
-	p1.y.ModNeg();
-	Secp256K1::GetHash160(searchType, compressed, p1, h0);
 	pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, -i, 0, compressed);
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h0, stat))
+		checkAddr<matcher>(pr0, h0, key, i, 2, compressed);
+	pr0 = *(prefix_t*)h1;
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h1, stat))
+		checkAddr<matcher>(pr0, h1, key, -i, 0, compressed);
 
-	// Endomorphism #1
-	pte1[0].y.ModNeg();
+	// Endomorphism #1 and #2
+	pte1[0].y.Set(ps.y);
+	pte2[0].y.Set(ps.y);
 
-	Secp256K1::GetHash160(searchType, compressed, pte1[0], h0);
+	Secp256K1::GetHash160<type, compressed>(pte1[0], pte2[0], h0, h1);
 
 	pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, -i, 1, compressed);
-
-	// Endomorphism #2
-	pte2[0].y.ModNeg();
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h0, stat))
+		checkAddr<matcher>(pr0, h0, key, -i, 1, compressed);
+	pr0 = *(prefix_t*)h1;
+	if (matcher == MATCH_PATTERN || isCandidate(pr0, h1, stat))
+		checkAddr<matcher>(pr0, h1, key, -i, 2, compressed);
 
-	Secp256K1::GetHash160(searchType, compressed, pte2[0], h0);
-
-	pr0 = *(prefix_t*)h0;
-	if (hasPattern || prefixes[pr0].items)
-		checkAddr(pr0, h0, key, -i, 2, compressed);
+	addFilterStat(stat);
 
 }
 
 // ----------------------------------------------------------------------------
 
-void VanitySearch::checkPublicKeys(const Int& key, int i, const Point& p1, const Point& p2, const Point& p3, const Point& p4)
+void VanitySearch::checkPublicKeys(const Int& key, int i, const PointK1& p1, const PointK1& p2, const PointK1& p3, const PointK1& p4)
 {
 	prefix_t pr0;
 	prefix_t pr1;
 	prefix_t pr2;
 	prefix_t pr3;
-	pr0 = *(prefix_t*)&p1.x.bits16[NB16BLOCK - 5];;
-	pr1 = *(prefix_t*)&p2.x.bits16[NB16BLOCK - 5];;
-	pr2 = *(prefix_t*)&p3.x.bits16[NB16BLOCK - 5];;
-	pr3 = *(prefix_t*)&p4.x.bits16[NB16BLOCK - 5];;
-
-	
-
-	if (prefixes[pr0].items)
-		checkPubKey(pr0, key, i, 0, p1);
-	if (prefixes[pr1].items)
-		checkPubKey(pr1, key, i + 1, 0, p2);
-	if (prefixes[pr2].items)
-		checkPubKey(pr2, key, i + 2, 0, p3);
-	if (prefixes[pr3].items)
-		checkPubKey(pr3, key, i + 3, 0, p4);
+	Point p;
+	// Most significant 16 bits of x
+	pr0 = *(prefix_t*)&p1.x.bits16[15];
+	pr1 = *(prefix_t*)&p2.x.bits16[15];
+	pr2 = *(prefix_t*)&p3.x.bits16[15];
+	pr3 = *(prefix_t*)&p4.x.bits16[15];
+
+	if (hasPrefix(pr0)) {
+		p1.Get(p);
+		checkPubKey(pr0, key, i, 0, p);
+	}
+	if (hasPrefix(pr1)) {
+		p2.Get(p);
+		checkPubKey(pr1, key, i + 1, 0, p);
+	}
+	if (hasPrefix(pr2)) {
+		p3.Get(p);
+		checkPubKey(pr2, key, i + 2, 0, p);
+	}
+	if (hasPrefix(pr3)) {
+		p4.Get(p);
+		checkPubKey(pr3, key, i + 3, 0, p);
+	}
 }
 
-void VanitySearch::checkAddressesSSE(bool compressed, Int key, int i, Point p1, Point p2, Point p3, Point p4) {
-
-	unsigned char h0[20];
-	unsigned char h1[20];
-	unsigned char h2[20];
-	unsigned char h3[20];
-	Point pte1[4];
-	Point pte2[4];
-	prefix_t pr0;
-	prefix_t pr1;
-	prefix_t pr2;
-	prefix_t pr3;
+// Lane j of a lane-transposed hash160 (see Secp256K1::GetHash160T)
+#define GETHASH160T(d,h,n,j) \
+((uint32_t *)(d))[0] = (h)[(j)]; \
+((uint32_t *)(d))[1] = (h)[(n) + (j)]; \
+((uint32_t *)(d))[2] = (h)[2 * (n) + (j)]; \
+((uint32_t *)(d))[3] = (h)[3 * (n) + (j)]; \
+((uint32_t *)(d))[4] = (h)[4 * (n) + (j)];
+
+template<int type, bool compressed, int matcher>
+void VanitySearch::checkAddressesSIMD(const Int& key, int i, const PointK1* p) {
+
+	// 4 points (SSE), 8 points (AVX2) or 16 points (AVX-512) per call
+	int n = Secp256K1::GetHashBackendWidth(hashBackend);
+	uint32_t h[5 * 16];
+	unsigned char hj[4][20];
+	PointK1 pt[16];
+	PointK1 pte1[16];
+	PointK1 pte2[16];
+	Int x;
+	Int e;
+	uint32_t stat[2] = { 0, 0 };
+
+	for (int j = 0; j < n; j++) {
+		pt[j] = p[j];
+		p[j].x.Get(x);
+		// if (x, y) = k * G, then (beta*x, y) = lambda*k*G
+		e.ModMulK1(x, beta);
+		pte1[j].x.Set(e);
+		pte1[j].y = p[j].y;
+		// if (x, y) = k * G, then (beta2*x, y) = lambda2*k*G
+		e.ModMulK1(x, beta2);
+		pte2[j].x.Set(e);
+		pte2[j].y = p[j].y;
+	}
 
-	// Point -------------------------------------------------------------------------
-	Secp256K1::GetHash160(searchType, compressed, p1, p2, p3, p4, h0, h1, h2, h3);
+	// Point, Endomorphism #1, Endomorphism #2, then the same for the symetric points
+	// if (x,y) = k*G, then (x, -y) is -k*G
+	for (int s = 0; s < 2; s++) {
 
-	if (!hasPattern) {
+		int32_t incr = (s == 0) ? i : -i;
+		int32_t dir = (s == 0) ? 1 : -1;
 
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
+		for (int endo = 0; endo < 3; endo++) {
 
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, i, 0, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, i + 1, 0, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, i + 2, 0, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, i + 3, 0, compressed);
+			PointK1* q = (endo == 0) ? pt : ((endo == 1) ? pte1 : pte2);
 
-	}
-	else {
+			Secp256K1::GetHash160T<type, compressed>(hashBackend, q, h);
 
-		checkAddrSSE(h0, h1, h2, h3, i, i + 1, i + 2, i + 3, key, 0, compressed);
+			if (matcher != MATCH_PATTERN) {
 
-	}
+				// The prefix is the low 16 bits of the first hash160 word, the lookup
+				// items of the candidates are prefetched for the whole batch first
+				int nbHit = 0;
+				int hit[16];
+				for (int j = 0; j < n; j++) {
+					prefix_t pr = (prefix_t)h[j];
+					if (hasPrefix(pr)) {
+						GETHASH160T(hj[0], h, n, j);
+						if (isCandidate(pr, hj[0], stat))
+							hit[nbHit++] = j;
+					}
+				}
+				for (int k = 0; k < nbHit; k++)
+					_mm_prefetch((const char*)&lookupItems[prefixStart[(prefix_t)h[hit[k]]]], _MM_HINT_T0);
+				for (int k = 0; k < nbHit; k++) {
+					int j = hit[k];
+					GETHASH160T(hj[0], h, n, j);
+					checkAddr<matcher>((prefix_t)h[j], hj[0], key, incr + dir * j, endo, compressed);
+				}
 
-	// Endomorphism #1
-	// if (x, y) = k * G, then (beta*x, y) = lambda*k*G
-	pte1[0].x.ModMulK1(p1.x, beta);
-	pte1[0].y.Set(p1.y);
-	pte1[1].x.ModMulK1(p2.x, beta);
-	pte1[1].y.Set(p2.y);
-	pte1[2].x.ModMulK1(p3.x, beta);
-	pte1[2].y.Set(p3.y);
-	pte1[3].x.ModMulK1(p4.x, beta);
-	pte1[3].y.Set(p4.y);
+			}
+			else {
 
-	Secp256K1::GetHash160(searchType, compressed, pte1[0], pte1[1], pte1[2], pte1[3], h0, h1, h2, h3);
+				for (int j = 0; j < n; j += 4) {
+					GETHASH160T(hj[0], h, n, j);
+					GETHASH160T(hj[1], h, n, j + 1);
+					GETHASH160T(hj[2], h, n, j + 2);
+					GETHASH160T(hj[3], h, n, j + 3);
+					checkAddrSSE(hj[0], hj[1], hj[2], hj[3],
+						incr + dir * j, incr + dir * (j + 1), incr + dir * (j + 2), incr + dir * (j + 3), key, endo, compressed);
+				}
 
-	if (!hasPattern) {
+			}
 
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
+		}
 
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, i, 1, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, (i + 1), 1, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, (i + 2), 1, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, (i + 3), 1, compressed);
+		if (s == 0) {
+			// The 3 points share the same y
+			for (int j = 0; j < n; j++) {
+				pt[j].y.Get(e);
+				e.ModNeg();
+				pt[j].y.Set(e);
+				pte1[j].y = pt[j].y;
+				pte2[j].y = pt[j].y;
+			}
+		}
 
 	}
-	else {
 
-		checkAddrSSE(h0, h1, h2, h3, i, i + 1, i + 2, i + 3, key, 1, compressed);
+	addFilterStat(stat);
 
-	}
+}
 
-	// Endomorphism #2
-	// if (x, y) = k * G, then (beta2*x, y) = lambda2*k*G
-	pte2[0].x.ModMulK1(p1.x, beta2);
-	pte2[0].y.Set(p1.y);
-	pte2[1].x.ModMulK1(p2.x, beta2);
-	pte2[1].y.Set(p2.y);
-	pte2[2].x.ModMulK1(p3.x, beta2);
-	pte2[2].y.Set(p3.y);
-	pte2[3].x.ModMulK1(p4.x, beta2);
-	pte2[3].y.Set(p4.y);
+// ----------------------------------------------------------------------------
+// Search kernels: one instantiation per (mode, address type, matcher), selected
+// once per thread by selectCheckGroup(), the group loop has no mode branch.
+// pts[0..count) are the points first..first+count-1 of the group (a tile).
 
-	Secp256K1::GetHash160(searchType, compressed, pte2[0], pte2[1], pte2[2], pte2[3], h0, h1, h2, h3);
+template<int mode, int type, int matcher>
+void VanitySearch::checkGroup(const Int& key, const PointK1* pts, int first, int count) {
 
-	if (!hasPattern) {
+	Point p;
 
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
+	for (int i = 0; i < count && !endOfSearch; i++) {
+		pts[i].Get(p);
+		if (mode != SEARCH_UNCOMPRESSED)
+			checkAddresses<type, true, matcher>(key, first + i, p);
+		if (mode != SEARCH_COMPRESSED)
+			checkAddresses<type, false, matcher>(key, first + i, p);
+	}
 
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, i, 2, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, (i + 1), 2, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, (i + 2), 2, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, (i + 3), 2, compressed);
+}
 
-	}
-	else {
+template<int mode, int type, int matcher>
+void VanitySearch::checkGroupSIMD(const Int& key, const PointK1* pts, int first, int count) {
 
-		checkAddrSSE(h0, h1, h2, h3, i, i + 1, i + 2, i + 3, key, 2, compressed);
+	int n = Secp256K1::GetHashBackendWidth(hashBackend);
 
+	for (int i = 0; i < count && !endOfSearch; i += n) {
+		if (mode != SEARCH_UNCOMPRESSED)
+			checkAddressesSIMD<type, true, matcher>(key, first + i, pts + i);
+		if (mode != SEARCH_COMPRESSED)
+			checkAddressesSIMD<type, false, matcher>(key, first + i, pts + i);
 	}
 
-	// Curve symetrie -------------------------------------------------------------------------
-	// if (x,y) = k*G, then (x, -y) is -k*G
+}
 
-	p1.y.ModNeg();
-	p2.y.ModNeg();
-	p3.y.ModNeg();
-	p4.y.ModNeg();
+void VanitySearch::checkGroupPubKeys(const Int& key, const PointK1* pts, int first, int count) {
 
-	Secp256K1::GetHash160(searchType, compressed, p1, p2, p3, p4, h0, h1, h2, h3);
+	for (int i = 0; i < count && !endOfSearch; i += 4)
+		checkPublicKeys(key, first + i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
 
-	if (!hasPattern) {
+}
 
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
+template<int mode, int type>
+VanitySearch::CHECK_GROUP VanitySearch::selectCheckGroup(int matcher, bool simd) {
 
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, -i, 0, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, -(i + 1), 0, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, -(i + 2), 0, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, -(i + 3), 0, compressed);
+	if (matcher == MATCH_PATTERN)
+		return simd ? &VanitySearch::checkGroupSIMD<mode, type, MATCH_PATTERN> : &VanitySearch::checkGroup<mode, type, MATCH_PATTERN>;
+	return simd ? &VanitySearch::checkGroupSIMD<mode, type, MATCH_PREFIX> : &VanitySearch::checkGroup<mode, type, MATCH_PREFIX>;
 
-	}
-	else {
+}
 
-		checkAddrSSE(h0, h1, h2, h3, -i, -(i + 1), -(i + 2), -(i + 3), key, 0, compressed);
+template<int mode>
+VanitySearch::CHECK_GROUP VanitySearch::selectCheckGroup(int type, int matcher, bool simd) {
 
+	switch (type) {
+	case P2SH:
+		return selectCheckGroup<mode, P2SH>(matcher, simd);
+	case BECH32:
+		return selectCheckGroup<mode, BECH32>(matcher, simd);
+	default:
+		return selectCheckGroup<mode, P2PKH>(matcher, simd);
 	}
 
-	// Endomorphism #1
-	// if (x, y) = k * G, then (beta*x, y) = lambda*k*G
-	pte1[0].y.ModNeg();
-	pte1[1].y.ModNeg();
-	pte1[2].y.ModNeg();
-	pte1[3].y.ModNeg();
-
-
-	Secp256K1::GetHash160(searchType, compressed, pte1[0], pte1[1], pte1[2], pte1[3], h0, h1, h2, h3);
-
-	if (!hasPattern) {
-
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
-
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, -i, 1, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, -(i + 1), 1, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, -(i + 2), 1, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, -(i + 3), 1, compressed);
+}
 
-	}
-	else {
+VanitySearch::CHECK_GROUP VanitySearch::selectCheckGroup() {
 
-		checkAddrSSE(h0, h1, h2, h3, -i, -(i + 1), -(i + 2), -(i + 3), key, 1, compressed);
+	int matcher = hasPattern ? MATCH_PATTERN : MATCH_PREFIX;
+	bool simd = (hashBackend != HASH_SCALAR);
 
+	switch (searchMode) {
+	case SEARCH_COMPRESSED:
+		return selectCheckGroup<SEARCH_COMPRESSED>(searchType, matcher, simd);
+	case SEARCH_UNCOMPRESSED:
+		return selectCheckGroup<SEARCH_UNCOMPRESSED>(searchType, matcher, simd);
+	case SEARCH_BOTH:
+		return selectCheckGroup<SEARCH_BOTH>(searchType, matcher, simd);
+	default:
+		return &VanitySearch::checkGroupPubKeys;
 	}
 
-	// Endomorphism #2
-	// if (x, y) = k * G, then (beta2*x, y) = lambda2*k*G
-	pte2[0].y.ModNeg();
-	pte2[1].y.ModNeg();
-	pte2[2].y.ModNeg();
-	pte2[3].y.ModNeg();
+}
 
-	Secp256K1::GetHash160(searchType, compressed, pte2[0], pte2[1], pte2[2], pte2[3], h0, h1, h2, h3);
+// ----------------------------------------------------------------------------
+// CPU group generator table, the one baked in CPUGroup.h (generated at build time for
+// CPU_GRP_SIZE) is used for the default group size, other sizes (-g) are computed.
 
-	if (!hasPattern) {
+void VanitySearch::InitCPUGroup(int grpSize) {
 
-		pr0 = *(prefix_t*)h0;
-		pr1 = *(prefix_t*)h1;
-		pr2 = *(prefix_t*)h2;
-		pr3 = *(prefix_t*)h3;
+	delete[] GnBuff;
+	GnBuff = NULL;
+	cpuGrpSize = grpSize;
 
-		if (prefixes[pr0].items)
-			checkAddr(pr0, h0, key, -i, 2, compressed);
-		if (prefixes[pr1].items)
-			checkAddr(pr1, h1, key, -(i + 1), 2, compressed);
-		if (prefixes[pr2].items)
-			checkAddr(pr2, h2, key, -(i + 2), 2, compressed);
-		if (prefixes[pr3].items)
-			checkAddr(pr3, h3, key, -(i + 3), 2, compressed);
+	if (grpSize == CPUGROUP_GRP_SIZE) {
+		Gn = (const PointK1*)CPU_Gn;
+		_2Gn = *(const PointK1*)CPU_2Gn;
+		return;
+	}
 
+	// Compute Generator table G[n] = (n+1)*G
+	GnBuff = new PointK1[grpSize / 2];
+	Point g = Secp256K1::G;
+	GnBuff[0].Set(g);
+	g = Secp256K1::DoubleDirect(g);
+	GnBuff[1].Set(g);
+	for (int i = 2; i < grpSize / 2; i++) {
+		g = Secp256K1::AddDirect(g, Secp256K1::G);
+		GnBuff[i].Set(g);
 	}
-	else {
+	// _2Gn = grpSize*G
+	_2Gn.Set(Secp256K1::DoubleDirect(g));
+	Gn = GnBuff;
 
-		checkAddrSSE(h0, h1, h2, h3, -i, -(i + 1), -(i + 2), -(i + 3), key, 2, compressed);
+}
 
-	}
+void VanitySearch::SetCPUStreams(int nbStream) {
+
+	cpuStreams = nbStream;
 
 }
 
@@ -1421,7 +1690,7 @@ void VanitySearch::getCPUStartingKey(int thId, Int & key, Point & startP) {
 		key.Add(off);
 	}
 	Int km(key);
-	km.Add((uint64_t)CPU_GRP_SIZE / 2);
+	km.Add((uint64_t)(cpuGrpSize / 2));
 	startP = Secp256K1::ComputePublicKey(km);
 	if (startPubKeySpecified)
 		startP = Secp256K1::AddDirect(startP, startPubKey);
@@ -1434,44 +1703,77 @@ void VanitySearch::FindKeyCPU(TH_PARAM * ph) {
 	int thId = ph->threadId;
 	counters[thId] = 0;
 
-	// CPU Thread
-	IntGroup* grp = new IntGroup(CPU_GRP_SIZE / 2 + 1);
+	// CPU Thread, nbStream groups (distinct base keys) are walked in lockstep,
+	// their deltas are inverted together
+	int grpSize = cpuGrpSize;
+	int nbStream = cpuStreams;
+	int c = grpSize / 2;
+	IntGroup* grp = new IntGroup(nbStream * (c + 1), fieldBackend);
 
 	// Group Init
-	Int  key;
-	Point startP;
-	getCPUStartingKey(thId, key, startP);
-
-	Int dx[CPU_GRP_SIZE / 2 + 1];
-	Point pts[CPU_GRP_SIZE];
-
+	Int  key[CPU_STREAM_MAX];
+	Point startP[CPU_STREAM_MAX];
+	for (int s = 0; s < nbStream; s++)
+		getCPUStartingKey(thId * nbStream + s, key[s], startP[s]);
+
+	// Compact deltas (IntK1): 16 KB instead of 20 KB with Int (1024 points),
+	// the deltas of stream s start at dx + s*(c+1).
+	// Points are generated then checked by tiles of CPU_TILE_SIZE pairs which stay
+	// in L1, the group points are never stored:
+	// up[s][0..T) are the points c+a..c+a+T-1 (up[s][0] is carried from the previous tile),
+	// lo[s][0..T) are the points c-a-T..c-a-1 (c = grpSize/2, a = first pair of the tile)
+	IntK1* dx = new IntK1[nbStream * (c + 1)];
+	PointK1 up[CPU_STREAM_MAX][CPU_TILE_SIZE + 1];
+	PointK1 lo[CPU_STREAM_MAX][CPU_TILE_SIZE];
+	const IntK1* dxs[CPU_STREAM_MAX];
+	PointK1* ups[CPU_STREAM_MAX];
+	PointK1* los[CPU_STREAM_MAX];
+
+	Int d;
 	Int dy;
 	Int dyn;
 	Int _s;
 	Int _p;
+	Point g;
 	Point pp;
 	Point pn;
 	grp->Set(dx);
 
+	// Search kernel of this search mode, address type and matcher
+	CHECK_GROUP checkGroup = selectCheckGroup();
+
 	ph->hasStarted = true;
 	ph->rekeyRequest = false;
 
 	while (!endOfSearch) {
 
 		if (ph->rekeyRequest) {
-			getCPUStartingKey(thId, key, startP);
+			for (int s = 0; s < nbStream; s++)
+				getCPUStartingKey(thId * nbStream + s, key[s], startP[s]);
 			ph->rekeyRequest = false;
 		}
 
 		// Fill group
 		int i;
-		int hLength = (CPU_GRP_SIZE / 2 - 1);
+		int hLength = (grpSize / 2 - 1);
 
 		for (i = 0; i < hLength; i++) {
-			dx[i].ModSub(Gn[i].x, startP.x);
+			Gn[i].x.Get(g.x);
+			for (int s = 0; s < nbStream; s++) {
+				d.ModSubK1(g.x, startP[s].x);
+				dx[s * (c + 1) + i].Set(d);
+			}
+		}
+		Gn[i].x.Get(g.x);
+		for (int s = 0; s < nbStream; s++) {
+			d.ModSubK1(g.x, startP[s].x);  // For the first point
+			dx[s * (c + 1) + i].Set(d);
+		}
+		_2Gn.x.Get(g.x);
+		for (int s = 0; s < nbStream; s++) {
+			d.ModSubK1(g.x, startP[s].x);  // For the next center point
+			dx[s * (c + 1) + i + 1].Set(d);
 		}
-		dx[i].ModSub(Gn[i].x, startP.x);  // For the first point
-		dx[i + 1].ModSub(_2Gn.x, startP.x); // For the next center point
 
 		// Grouped ModInv
 		grp->ModInv();
@@ -1480,153 +1782,104 @@ void VanitySearch::FindKeyCPU(TH_PARAM * ph) {
 		// We compute key in the positive and negative way from the center of the group
 
 		// center point
-		pts[CPU_GRP_SIZE / 2] = startP;
-
-		for (i = 0; i < hLength && !endOfSearch; i++) {
+		for (int s = 0; s < nbStream; s++)
+			up[s][0].Set(startP[s]);
 
-			pp = startP;
-			pn = startP;
+		int n = Secp256K1::GetFieldBackendWidth(fieldBackend);
 
-			// P = startP + i*G
-			dy.ModSub(Gn[i].y, pp.y);
+		for (int a = 0; a < c && !endOfSearch; a += CPU_TILE_SIZE) {
 
-			_s.ModMulK1(dy, dx[i]);       // s = (p2.y-p1.y)*inverse(p2.x-p1.x);
-			_p.ModSquareK1(_s);            // _p = pow2(s)
+			// The last tile ends with the first point (startP - (GRP_SZIE/2)*G)
+			int nbPair = (a + CPU_TILE_SIZE < c) ? CPU_TILE_SIZE : CPU_TILE_SIZE - 1;
 
-			pp.x.ModNeg();
-			pp.x.ModAdd(_p);
-			pp.x.ModSub(Gn[i].x);           // rx = pow2(s) - p1.x - p2.x;
-
-			pp.y.ModSub(Gn[i].x, pp.x);
-			pp.y.ModMulK1(_s);
-			pp.y.ModSub(Gn[i].y);           // ry = - p2.y - s*(ret.x-p2.x);
+			// startP + (a+j+1)*G and startP - (a+j+1)*G, j = 0..n-1 (vectorized field
+			// backends), the scalar steps (and the tail) of the streams are interleaved
+			int j = 0;
+			if (n > 1) {
+				for (; j + n - 1 < nbPair; j += n)
+					for (int s = 0; s < nbStream; s++)
+						Secp256K1::AddGroupT(fieldBackend, startP[s], Gn + a + j, dx + s * (c + 1) + a + j,
+							up[s] + 1 + j, lo[s] + CPU_TILE_SIZE - 1 - j);
+			}
+			for (; j < nbPair; j++) {
+				for (int s = 0; s < nbStream; s++) {
+					dxs[s] = dx + s * (c + 1) + a + j;
+					ups[s] = up[s] + 1 + j;
+					los[s] = lo[s] + CPU_TILE_SIZE - 1 - j;
+				}
+				Secp256K1::AddGroupN(nbStream, startP, Gn[a + j], dxs, ups, los);
+			}
 
-			// P = startP - i*G  , if (x,y) = i*G then (x,-y) = -i*G
-			dyn.Set(Gn[i].y);
-			dyn.ModNeg();
-			dyn.ModSub(pn.y);
+			if (nbPair < CPU_TILE_SIZE) {
 
-			_s.ModMulK1(dyn, dx[i]);      // s = (p2.y-p1.y)*inverse(p2.x-p1.x);
-			_p.ModSquareK1(_s);            // _p = pow2(s)
+				// First point (startP - (GRP_SZIE/2)*G)
+				Gn[hLength].Get(g);
+				for (int s = 0; s < nbStream; s++) {
 
-			pn.x.ModNeg();
-			pn.x.ModAdd(_p);
-			pn.x.ModSub(Gn[i].x);          // rx = pow2(s) - p1.x - p2.x;
+					dx[s * (c + 1) + hLength].Get(d);
+					pn = startP[s];
+					dyn.ModAddK1(g.y, pn.y);
 
-			pn.y.ModSub(Gn[i].x, pn.x);
-			pn.y.ModMulK1(_s);
-			pn.y.ModAdd(Gn[i].y);          // ry = - p2.y - s*(ret.x-p2.x);
+					_s.ModMulK1(dyn, d);           // -s
+					_p.ModSquareK1(_s);
 
-			pts[CPU_GRP_SIZE / 2 + (i + 1)] = pp;
-			pts[CPU_GRP_SIZE / 2 - (i + 1)] = pn;
+					pn.x.ModSubK1(_p, startP[s].x);
+					pn.x.ModSubK1(g.x);
 
-		}
+					pn.y.ModSubK1(pn.x, g.x);
+					pn.y.ModMulK1(_s);
+					pn.y.ModAddK1(g.y);
 
-		// First point (startP - (GRP_SZIE/2)*G)
-		pn = startP;
-		dyn.Set(Gn[i].y);
-		dyn.ModNeg();
-		dyn.ModSub(pn.y);
+					pn.x.ModNormK1();
+					pn.y.ModNormK1();
+					lo[s][0].Set(pn);
 
-		_s.ModMulK1(dyn, dx[i]);
-		_p.ModSquareK1(_s);
+				}
 
-		pn.x.ModNeg();
-		pn.x.ModAdd(_p);
-		pn.x.ModSub(Gn[i].x);
+			}
 
-		pn.y.ModSub(Gn[i].x, pn.x);
-		pn.y.ModMulK1(_s);
-		pn.y.ModAdd(Gn[i].y);
+			// Check addresses of the tile
+			for (int s = 0; s < nbStream; s++) {
+				(this->*checkGroup)(key[s], up[s], c + a, CPU_TILE_SIZE);
+				(this->*checkGroup)(key[s], lo[s], c - a - CPU_TILE_SIZE, CPU_TILE_SIZE);
+				up[s][0] = up[s][CPU_TILE_SIZE];
+			}
 
-		pts[0] = pn;
+		}
 
 		// Next start point (startP + GRP_SIZE*G)
-		pp = startP;
-		dy.ModSub(_2Gn.y, pp.y);
-
-		_s.ModMulK1(dy, dx[i + 1]);
-		_p.ModSquareK1(_s);
-
-		pp.x.ModNeg();
-		pp.x.ModAdd(_p);
-		pp.x.ModSub(_2Gn.x);
+		_2Gn.Get(g);
+		for (int s = 0; s < nbStream; s++) {
 
-		pp.y.ModSub(_2Gn.x, pp.x);
-		pp.y.ModMulK1(_s);
-		pp.y.ModSub(_2Gn.y);
-		startP = pp;
+			dx[s * (c + 1) + hLength + 1].Get(d);
+			pp = startP[s];
+			dy.ModSubK1(g.y, pp.y);
 
-#if 0
-		// Check
-		{
-			bool wrong = false;
-			Point p0 = secp.ComputePublicKey(&key);
-			for (int i = 0; i < CPU_GRP_SIZE; i++) {
-				if (!p0.equals(pts[i])) {
-					wrong = true;
-					printf("[%d] wrong point\n", i);
-				}
-				p0 = secp.NextKey(p0);
-	}
-			if (wrong) exit(0);
-}
-#endif
+			_s.ModMulK1(dy, d);
+			_p.ModSquareK1(_s);
 
-		// Check addresses
-		if (useSSE) {
-
-			for (int i = 0; i < CPU_GRP_SIZE && !endOfSearch; i += 4) {
-
-				switch (searchMode) {
-				case SEARCH_COMPRESSED:
-					checkAddressesSSE(true, key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					break;
-				case SEARCH_UNCOMPRESSED:
-					checkAddressesSSE(false, key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					break;
-				case SEARCH_BOTH:
-					checkAddressesSSE(true, key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					checkAddressesSSE(false, key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					break;
-
-				case SEARCH_PUBLICKEYS:
-					checkPublicKeys(key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					break;
-				}
+			pp.x.ModSubK1(_p, startP[s].x);
+			pp.x.ModSubK1(g.x);
 
-			}
-
-		}
-		else {
+			pp.y.ModSubK1(g.x, pp.x);
+			pp.y.ModMulK1(_s);
+			pp.y.ModSubK1(g.y);
 
-			for (int i = 0; i < CPU_GRP_SIZE && !endOfSearch; i++) {
-
-				switch (searchMode) {
-				case SEARCH_COMPRESSED:
-					checkAddresses(true, key, i, pts[i]);
-					break;
-				case SEARCH_UNCOMPRESSED:
-					checkAddresses(false, key, i, pts[i]);
-					break;
-				case SEARCH_BOTH:
-					checkAddresses(true, key, i, pts[i]);
-					checkAddresses(false, key, i, pts[i]);
-					break;
-				case SEARCH_PUBLICKEYS:
-					checkPublicKeys(key, i, pts[i], pts[i + 1], pts[i + 2], pts[i + 3]);
-					break;
-				}
+			// Normalized: the center point is hashed
+			pp.x.ModNormK1();
+			pp.y.ModNormK1();
+			startP[s] = pp;
 
-			}
+			key[s].Add((uint64_t)grpSize);
 
 		}
 
-		key.Add((uint64_t)CPU_GRP_SIZE);
-		counters[thId] += 6 * CPU_GRP_SIZE; // Point + endo #1 + endo #2 + Symetric point + endo #1 + endo #2
+		counters[thId] += 6 * grpSize * nbStream; // Point + endo #1 + endo #2 + Symetric point + endo #1 + endo #2
 
-}
+	}
 
+	delete[] dx;
+	delete grp;
 	ph->isRunning = false;
 
 }
@@ -1648,14 +1901,17 @@ void VanitySearch::getGPUStartingKeys(int thId, int groupSize, int nbThread, Int
 			keys[i].Add(offT);
 			keys[i].Add(offG);
 		}
-		Int k(keys[i]);
-		// Starting key is at the middle of the group
-		k.Add((uint64_t)(groupSize / 2));
-		p[i] = Secp256K1::ComputePublicKey(k);
-		if (startPubKeySpecified)
-			p[i] = Secp256K1::AddDirect(p[i], startPubKey);
 	}
 
+	// Starting keys are at the middle of the group
+	Int* k = new Int[nbThread];
+	for (int i = 0; i < nbThread; i++) {
+		k[i].Set(keys[i]);
+		k[i].Add((uint64_t)(groupSize / 2));
+	}
+	Secp256K1::ComputePublicKeyBatch(k, p, nbThread, startPubKeySpecified ? &startPubKey : NULL, Timer::getCoreNumber());
+	delete[] k;
+
 }
 
 void VanitySearch::FindKeyGPU(TH_PARAM * ph) {
@@ -1807,6 +2063,13 @@ void VanitySearch::Search(int nbThread, std::vector<int> gpuId, std::vector<int>
 	memset(counters, 0, sizeof(counters));
 
 	printf("Number of CPU thread: %d\n", nbCPUThread);
+	if (nbCPUThread > 0) {
+		printf("CPU hash backend: %s\n", Secp256K1::GetHashBackendName(hashBackend));
+		printf("CPU field backend: %s%s\n", Secp256K1::GetFieldBackendName(fieldBackend), Int::mulxAdx ? " (mulx/adx)" : "");
+		printf("CPU group size: %d\n", cpuGrpSize);
+		if (cpuStreams > 1)
+			printf("CPU streams per thread: %d\n", cpuStreams);
+	}
 
 	TH_PARAM* params = (TH_PARAM*)malloc((nbCPUThread + nbGPUThread) * sizeof(TH_PARAM));
 	memset(params, 0, (nbCPUThread + nbGPUThread) * sizeof(TH_PARAM));
@@ -1903,9 +2166,16 @@ void VanitySearch::Search(int nbThread, std::vector<int> gpuId, std::vector<int>
 		avgGpuKeyRate /= (double)(nbSample);
 
 		if (isAlive(params)) {
-			printf("\r[%.2f Mkey/s][GPU %.2f Mkey/s][Total 2^%.2f]%s[Found %d]  ",
+			// Measured filter hit rate
+			string filterInfo;
+			if (filterProbe > 0) {
+				char tmp[64];
+				sprintf(tmp, "[Filter %.3f%%]", (double)filterPass * 100.0 / (double)filterProbe);
+				filterInfo = tmp;
+			}
+			printf("\r[%.2f Mkey/s][GPU %.2f Mkey/s][Total 2^%.2f]%s%s[Found %d]  ",
 				avgKeyRate / 1000000.0, avgGpuKeyRate / 1000000.0,
-				log2((double)count), GetExpectedTime(avgKeyRate, (double)count).c_str(), nbFoundKey);
+				log2((double)count), GetExpectedTime(avgKeyRate, (double)count).c_str(), filterInfo.c_str(), nbFoundKey);
 		}
 
 		if (rekey > 0) {
@@ -1926,6 +2196,258 @@ void VanitySearch::Search(int nbThread, std::vector<int> gpuId, std::vector<int>
 
 	}
 
+// ----------------------------------------------------------------------------
+// Autotune: short timed trials of the CPU search (FindKeyCPU), hits are ignored.
+// Hash backend, field backend, group size, streams and thread count are tuned one
+// after the other, each stage keeping the best setting of the previous ones.
+
+#define TUNE_WARMUP 500
+#define TUNE_TRIAL 2000
+
+double VanitySearch::runTrial(int nbThread, uint32_t millis) {
+
+	endOfSearch = false;
+	nbCPUThread = nbThread;
+	nbGPUThread = 0;
+	memset(counters, 0, sizeof(counters));
+
+	TH_PARAM* params = (TH_PARAM*)malloc(nbThread * sizeof(TH_PARAM));
+	memset(params, 0, nbThread * sizeof(TH_PARAM));
+
+	for (int i = 0; i < nbThread; i++) {
+		params[i].obj = this;
+		params[i].threadId = i;
+		params[i].isRunning = true;
+#ifdef WIN64
+		DWORD thread_id;
+		CloseHandle(CreateThread(NULL, 0, _FindKey, (void*)(params + i), 0, &thread_id));
+#else
+		pthread_t thread_id;
+		pthread_create(&thread_id, NULL, &_FindKey, (void*)(params + i));
+		pthread_detach(thread_id);
+#endif
+	}
+
+	while (!hasStarted(params))
+		Timer::SleepMillis(10);
+	Timer::SleepMillis(TUNE_WARMUP);
+
+	uint64_t c0 = getCPUCount();
+	double t0 = Timer::get_tick();
+	Timer::SleepMillis(millis);
+	uint64_t c1 = getCPUCount();
+	double t1 = Timer::get_tick();
+
+	// Wait for the end of all threads
+	endOfSearch = true;
+	bool running = true;
+	while (running) {
+		running = false;
+		for (int i = 0; i < nbThread; i++)
+			running = running || params[i].isRunning;
+		if (running)
+			Timer::SleepMillis(10);
+	}
+	endOfSearch = false;
+	free(params);
+
+	return (double)(c1 - c0) / (t1 - t0);
+
+}
+
+void VanitySearch::tuneTrial(TUNE_PROFILE& p, TUNE_PROFILE& best) {
+
+	SetProfile(p);
+	p.keyRate = runTrial(p.nbThread, TUNE_TRIAL);
+	printf("  [grp %4d][stream %d][thread %3d][hash %-6s][field %-6s] %.3f Mkey/s\n", p.grpSize, p.nbStream,
+		p.nbThread, Secp256K1::GetHashBackendName(p.hashBackend), Secp256K1::GetFieldBackendName(p.fieldBackend),
+		p.keyRate / 1000000.0);
+	if (p.keyRate > best.keyRate)
+		best = p;
+
+}
+
+void VanitySearch::Autotune(int maxThread, TUNE_PROFILE& best) {
+
+	TUNE_PROFILE p;
+
+	printf("Autotune (%d ms trials)\n", TUNE_TRIAL);
+#ifdef WIN64
+	ghMutex = CreateMutex(NULL, FALSE, NULL);
+#else
+	ghMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+	tuning = true;
+
+	best.grpSize = cpuGrpSize;
+	best.nbThread = maxThread;
+	best.hashBackend = hashBackend;
+	best.fieldBackend = fieldBackend;
+	best.nbStream = cpuStreams;
+	best.keyRate = 0.0;
+
+	// Hash backend (scalar only if nothing else is supported)
+	for (int b = HASH_SCALAR; b < HASH_NB_BACKEND; b++) {
+		if (!Secp256K1::IsHashBackendSupported(b) || (b == HASH_SCALAR && Secp256K1::GetHashBackend() != HASH_SCALAR))
+			continue;
+		p = best;
+		p.hashBackend = b;
+		tuneTrial(p, best);
+	}
+
+	// Field backend
+	TUNE_PROFILE ref = best;
+	for (int b = FIELD_SCALAR; b < FIELD_NB_BACKEND; b++) {
+		if (!Secp256K1::IsFieldBackendSupported(b) || b == ref.fieldBackend)
+			continue;
+		p = ref;
+		p.fieldBackend = b;
+		tuneTrial(p, best);
+	}
+
+	// Group size
+	ref = best;
+	for (int g = CPU_GRP_SIZE_MIN; g <= CPU_GRP_SIZE_MAX; g *= 2) {
+		if (g == ref.grpSize)
+			continue;
+		p = ref;
+		p.grpSize = g;
+		tuneTrial(p, best);
+	}
+
+	// Streams per thread
+	ref = best;
+	for (int s = 1; s <= CPU_STREAM_MAX; s *= 2) {
+		if (s == ref.nbStream)
+			continue;
+		p = ref;
+		p.nbStream = s;
+		tuneTrial(p, best);
+	}
+
+	// Thread count (all logical cores, one per SMT pair, one core left free)
+	ref = best;
+	int nbT[2] = { maxThread / 2, maxThread - 1 };
+	for (int i = 0; i < 2; i++) {
+		if (nbT[i] < 1 || nbT[i] == ref.nbThread || (i == 1 && nbT[1] == nbT[0]))
+			continue;
+		p = ref;
+		p.nbThread = nbT[i];
+		tuneTrial(p, best);
+	}
+
+	tuning = false;
+	SetProfile(best);
+
+	printf("Best: [grp %d][stream %d][thread %d][hash %s][field %s] %.3f Mkey/s\n", best.grpSize, best.nbStream,
+		best.nbThread, Secp256K1::GetHashBackendName(best.hashBackend), Secp256K1::GetFieldBackendName(best.fieldBackend),
+		best.keyRate / 1000000.0);
+
+}
+
+void VanitySearch::SetProfile(const TUNE_PROFILE& p) {
+
+	hashBackend = p.hashBackend;
+	fieldBackend = p.fieldBackend;
+	cpuStreams = p.nbStream;
+	if (p.grpSize != cpuGrpSize)
+		InitCPUGroup(p.grpSize);
+
+}
+
+// ----------------------------------------------------------------------------
+// Profile file: one line per host
+// host grpSize nbThread hashBackend fieldBackend keyRate [nbStream]
+
+string VanitySearch::GetProfileFile() {
+
+#ifdef WIN64
+	const char* home = getenv("USERPROFILE");
+#else
+	const char* home = getenv("HOME");
+#endif
+	string dir = (home != NULL) ? string(home) : string(".");
+	return dir + "/.VanitySearch.profile";
+
+}
+
+bool VanitySearch::LoadProfile(const string& fileName, TUNE_PROFILE& p) {
+
+	FILE* f = fopen(fileName.c_str(), "r");
+	if (f == NULL)
+		return false;
+
+	string host = Timer::getHostName();
+	char line[512];
+	char h[256];
+	char hb[32];
+	char fb[32];
+	bool found = false;
+
+	while (!found && fgets(line, sizeof(line), f) != NULL) {
+
+		// Profiles written before -streams have no stream count
+		TUNE_PROFILE t;
+		t.nbStream = 1;
+		if (sscanf(line, "%255s %d %d %31s %31s %lf %d", h, &t.grpSize, &t.nbThread, hb, fb, &t.keyRate, &t.nbStream) < 6)
+			continue;
+		if (host != h)
+			continue;
+
+		// Validate against this binary and CPU
+		t.hashBackend = -1;
+		t.fieldBackend = -1;
+		for (int b = 0; b < HASH_NB_BACKEND; b++)
+			if (strcmp(hb, Secp256K1::GetHashBackendName(b)) == 0 && Secp256K1::IsHashBackendSupported(b))
+				t.hashBackend = b;
+		for (int b = 0; b < FIELD_NB_BACKEND; b++)
+			if (strcmp(fb, Secp256K1::GetFieldBackendName(b)) == 0 && Secp256K1::IsFieldBackendSupported(b))
+				t.fieldBackend = b;
+		if (t.hashBackend < 0 || t.fieldBackend < 0 || t.nbThread < 1 || t.nbStream < 1 || t.nbStream > CPU_STREAM_MAX ||
+			t.grpSize < CPU_GRP_SIZE_MIN || t.grpSize > CPU_GRP_SIZE_MAX || (t.grpSize & (t.grpSize - 1)))
+			continue;
+
+		p = t;
+		found = true;
+
+	}
+
+	fclose(f);
+	return found;
+
+}
+
+bool VanitySearch::SaveProfile(const string& fileName, const TUNE_PROFILE& p) {
+
+	string host = Timer::getHostName();
+	vector<string> lines;
+	char line[512];
+	char h[256];
+
+	// Keep profiles of other hosts
+	FILE* f = fopen(fileName.c_str(), "r");
+	if (f != NULL) {
+		while (fgets(line, sizeof(line), f) != NULL) {
+			if (sscanf(line, "%255s", h) == 1 && host != h)
+				lines.push_back(string(line));
+		}
+		fclose(f);
+	}
+
+	f = fopen(fileName.c_str(), "w");
+	if (f == NULL) {
+		printf("Cannot write profile %s\n", fileName.c_str());
+		return false;
+	}
+	for (int i = 0; i < (int)lines.size(); i++)
+		fputs(lines[i].c_str(), f);
+	fprintf(f, "%s %d %d %s %s %.0f %d\n", host.c_str(), p.grpSize, p.nbThread,
+		Secp256K1::GetHashBackendName(p.hashBackend), Secp256K1::GetFieldBackendName(p.fieldBackend), p.keyRate, p.nbStream);
+	fclose(f);
+	return true;
+
+}
+
 // ----------------------------------------------------------------------------
 
 string VanitySearch::GetHex(vector<unsigned char> &buffer) {
@@ -21,12 +21,26 @@
 #include <string>
 #include <vector>
 #include "SECP256k1.h"
+#include "PrefixFilter.h"
 #include "GPU/GPUEngine.h"
 #ifdef WIN64
 #include <Windows.h>
 #endif
 
 #define CPU_GRP_SIZE 1024
+#define CPU_GRP_SIZE_MIN 256
+#define CPU_GRP_SIZE_MAX 4096
+
+// Point pairs generated then hashed per tile of the CPU group walk (kept in L1),
+// multiple of the widest hash backend (16) and divides CPU_GRP_SIZE_MIN/2
+#define CPU_TILE_SIZE 64
+
+// Independent groups walked in lockstep by each CPU thread (-streams)
+#define CPU_STREAM_MAX 4
+
+// Address matcher of the CPU search kernels
+#define MATCH_PREFIX 0   // Prefix lookup and hash160 ranges, then address compare (full addresses too)
+#define MATCH_PATTERN 1  // Wildcard match of every address
 
 class VanitySearch;
 
@@ -44,13 +58,27 @@ typedef struct {
 } TH_PARAM;
 
 
+// Inclusive hash160 range (big endian bounds), min64 and max64 are the first
+// 8 bytes of the bounds as integers
+typedef struct {
+
+	uint64_t min64;
+	uint64_t max64;
+	uint8_t min[20];
+	uint8_t max[20];
+
+} HASH160_RANGE;
+
+// A base58 prefix spans at most 2 address lengths
+#define PREFIX_RANGE_MAX 2
+
+// Parsed prefix, address or public key (see initPrefix)
 typedef struct {
 
 	char* prefix;
 	int prefixLength;
 	prefix_t sPrefix;
 	double difficulty;
-	bool* found;
 
 	// For dreamer ;)
 	bool isFull;
@@ -60,22 +88,70 @@ typedef struct {
 	Point pubkey;
 	int pubkeylen;
 
+	// Hash160 matching the prefix (addresses)
+	int nbRange;
+	HASH160_RANGE range[PREFIX_RANGE_MAX];
+
 } PREFIX_ITEM;
 
+// Targets of the search, structure of arrays carved from a single arena. A target is
+// a prefix, an address or a public key, the variants of a case unsensitive prefix are
+// targets of the same input prefix. Only the payload of the search mode is allocated.
+typedef struct {
+
+	uint32_t nbTarget;
+	uint32_t* input;          // Input prefix of the target
+	uint32_t* prefix;         // Offset of the prefix in pool (null terminated)
+	uint8_t* prefixLength;
+	char* pool;
+	uint32_t* range;          // Addresses: hash160 ranges range[t]..range[t+1]-1 of target t
+	uint64_t* rangeMin;       //   (first 8 bytes of the bounds)
+	uint64_t* rangeMax;
+	Point* pubkey;            // Public keys
+	uint8_t* pubkeyLength;
+
+	// Per input prefix
+	uint64_t* found;          // Bitset, set for the inputs that have nothing to search
+	double* difficulty;
+
+} TARGET_STORE;
+
+// Second level of the prefix lookup: a hash160 range of a target (min64 and max64 are
+// the first 8 bytes of its bounds as integers, the whole hash160 space for public keys)
 typedef struct {
 
-	std::vector<PREFIX_ITEM>* items;
-	bool found;
+	uint64_t min64;
+	uint64_t max64;
+	uint32_t target;
+
+} LOOKUP_ITEM;
+
+// CPU search profile (-autotune)
+typedef struct {
 
-} PREFIX_TABLE_ITEM;
+	int grpSize;
+	int nbThread;
+	int hashBackend;
+	int fieldBackend;
+	int nbStream;
+	double keyRate;
+
+} TUNE_PROFILE;
 
 class VanitySearch {
 
 public:
 
-	VanitySearch(std::vector<std::string>& prefix, std::string seed, int searchMode, bool useGpu, bool stop, std::string outputFile, bool useSSE, uint32_t maxFound, uint64_t rekey, bool caseSensitive, const Point& startPubKey, bool paranoiacSeed, const Int& startKey);
+	VanitySearch(std::vector<std::string>& prefix, std::string seed, int searchMode, bool useGpu, bool stop, std::string outputFile, int hashBackend, int fieldBackend, uint32_t maxFound, uint64_t rekey, bool caseSensitive, const Point& startPubKey, bool paranoiacSeed, const Int& startKey);
 
 	void Search(int nbThread, std::vector<int> gpuId, std::vector<int> gridSize);
+	void InitCPUGroup(int grpSize);
+	void SetCPUStreams(int nbStream);
+	void Autotune(int maxThread, TUNE_PROFILE& best);
+	void SetProfile(const TUNE_PROFILE& p);
+	static std::string GetProfileFile();
+	static bool LoadProfile(const std::string& fileName, TUNE_PROFILE& p);
+	static bool SaveProfile(const std::string& fileName, const TUNE_PROFILE& p);
 	void FindKeyCPU(TH_PARAM* p);
 	void FindKeyGPU(TH_PARAM* p);
 
@@ -85,14 +161,24 @@ private:
 	std::string GetExpectedTime(double keyRate, double keyCount);
 	bool checkPrivKey(std::string addr, const Int& key, int32_t incr, int endomorphism, bool mode);
 	void checkPubKey(int pi, const Int& key, int32_t incr, int endomorphism, const Point& pt);
-	void checkAddr(int prefIdx, uint8_t* hash160, Int& key, int32_t incr, int endomorphism, bool mode);
-	void checkAddrSSE(uint8_t* h1, uint8_t* h2, uint8_t* h3, uint8_t* h4, int32_t incr1, int32_t incr2, int32_t incr3, int32_t incr4, Int& key, int endomorphism, bool mode);
-	void checkAddresses(bool compressed, Int key, int i, Point p1);
-	void checkPublicKeys(const Int& key, int i, const Point& p1, const Point& p2, const Point& p3, const Point& p4);
-	void checkAddressesSSE(bool compressed, Int key, int i, Point p1, Point p2, Point p3, Point p4);
+	void checkAddrSSE(uint8_t* h1, uint8_t* h2, uint8_t* h3, uint8_t* h4, int32_t incr1, int32_t incr2, int32_t incr3, int32_t incr4, const Int& key, int endomorphism, bool mode);
+	void checkPublicKeys(const Int& key, int i, const PointK1& p1, const PointK1& p2, const PointK1& p3, const PointK1& p4);
+	void checkAddr(int prefIdx, uint8_t* hash160, const Int& key, int32_t incr, int endomorphism, bool mode);
+	template<int matcher> void checkAddr(int prefIdx, uint8_t* hash160, const Int& key, int32_t incr, int endomorphism, bool mode);
+	template<int type, bool compressed, int matcher> void checkAddresses(const Int& key, int i, const Point& p1);
+	template<int type, bool compressed, int matcher> void checkAddressesSIMD(const Int& key, int i, const PointK1* p);
+
+	// Checks the addresses of a tile of a CPU group (points first..first+count-1)
+	typedef void (VanitySearch::*CHECK_GROUP)(const Int& key, const PointK1* pts, int first, int count);
+	template<int mode, int type, int matcher> void checkGroup(const Int& key, const PointK1* pts, int first, int count);
+	template<int mode, int type, int matcher> void checkGroupSIMD(const Int& key, const PointK1* pts, int first, int count);
+	void checkGroupPubKeys(const Int& key, const PointK1* pts, int first, int count);
+	CHECK_GROUP selectCheckGroup();
+	template<int mode> CHECK_GROUP selectCheckGroup(int type, int matcher, bool simd);
+	template<int mode, int type> CHECK_GROUP selectCheckGroup(int matcher, bool simd);
 	void output(std::string addr, std::string pAddr, std::string pPubKey, std::string pAddrHex);
 	bool isAlive(TH_PARAM* p);
-	bool isSingularPrefix(std::string pref);
+	bool isSingularPrefix(const std::string& pref);
 	bool hasStarted(TH_PARAM* p);
 	void rekeyRequest(TH_PARAM* p);
 	uint64_t getGPUCount();
@@ -103,8 +189,9 @@ private:
 	void updateFound();
 	void getCPUStartingKey(int thId, Int& key, Point& startP);
 	void getGPUStartingKeys(int thId, int groupSize, int nbThread, Int* keys, Point* p);
-	void enumCaseUnsentivePrefix(std::string s, std::vector<std::string>& list);
 	bool prefixMatch(char* prefix, char* addr);
+	double runTrial(int nbThread, uint32_t millis);
+	void tuneTrial(TUNE_PROFILE& p, TUNE_PROFILE& best);
 
 	Int startKey;
 	Point startPubKey;
@@ -125,16 +212,46 @@ private:
 	uint64_t lastRekey;
 	uint32_t nbPrefix;
 	std::string outputFile;
-	bool useSSE;
+	int hashBackend;
+	int fieldBackend;
+	bool tuning;
 	bool onlyFull;
 	uint32_t maxFound;
 	double _difficulty;
 	bool* patternFound;
-	std::vector<PREFIX_TABLE_ITEM> prefixes;
 	std::vector<prefix_t> usedPrefix;
 	std::vector<LPREFIX> usedPrefixL;
 	std::vector<std::string>& inputPrefixes;
 
+	// Targets
+	TARGET_STORE targets;
+	uint8_t* targetArena;
+	std::vector<unsigned char> decodeBuffer;   // Base58 decoding of initPrefix()
+	void allocTargets(uint32_t nbInput, uint64_t nbTarget, uint64_t poolSize);
+	void addTarget(uint32_t input, const PREFIX_ITEM& it);
+	bool isFound(uint32_t input) const { return (targets.found[input >> 6] >> (input & 63)) & 1; }
+	void setFound(uint32_t input);
+
+	// Prefix lookup: bitmap of the used 16 bit prefixes (8 KB, L1 resident), then the
+	// items of prefix p stored contiguously in lookupItems[prefixStart[p]..prefixStart[p+1]-1]
+	uint64_t prefixBitmap[65536 / 64];
+	std::vector<uint32_t> prefixStart;
+	std::vector<LOOKUP_ITEM> lookupItems;
+	bool hasPrefix(prefix_t p) const { return (prefixBitmap[p >> 6] >> (p & 63)) & 1; }
+	// Then the filter of large target sets, stat[0] and stat[1] count its probes and passes
+	PrefixFilter filter;
+	uint64_t filterProbe;
+	uint64_t filterPass;
+	inline bool isCandidate(prefix_t p, const uint8_t* hash160, uint32_t* stat);
+	void addFilterStat(const uint32_t* stat);
+
+	// CPU group: Gn[i] = (i+1)*G, i < cpuGrpSize/2, _2Gn = cpuGrpSize*G
+	int cpuGrpSize;
+	int cpuStreams;
+	const PointK1* Gn;
+	PointK1* GnBuff;
+	PointK1 _2Gn;
+
 	Int beta;
 	Int lambda;
 	Int beta2;
@@ -41,6 +41,14 @@ void ripemd160_32(unsigned char *input, unsigned char *digest);
 void ripemd160sse_32(uint8_t *i0, uint8_t *i1, uint8_t *i2, uint8_t *i3,
   uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3);
 void ripemd160sse_test();
+void ripemd160avx2_32(uint8_t *i0, uint8_t *i1, uint8_t *i2, uint8_t *i3,
+  uint8_t *i4, uint8_t *i5, uint8_t *i6, uint8_t *i7,
+  uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3,
+  uint8_t *d4, uint8_t *d5, uint8_t *d6, uint8_t *d7);
+void ripemd160avx512_32(uint8_t *i[16], uint8_t *d[16]);
+void ripemd160sse_32_t(uint32_t *i, uint32_t *d);
+void ripemd160avx2_32_t(uint32_t *i, uint32_t *d);
+void ripemd160avx512_32_t(uint32_t *i, uint32_t *d);
 std::string ripemd160_hex(unsigned char *digest);
 
 static inline bool ripemd160_comp_hash(uint8_t *h0, uint8_t *h1) {
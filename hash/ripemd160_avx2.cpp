@@ -0,0 +1,570 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ripemd160.h"
+#include <string.h>
+#include <immintrin.h>
+
+// Internal AVX2 RIPEMD-160 implementation.
+namespace ripemd160avx2 {
+
+#ifdef WIN64
+  static const __declspec(align(32)) uint32_t _init[] = {
+#else
+  static const uint32_t _init[] __attribute__ ((aligned (32))) = {
+#endif
+      0x67452301ul,0x67452301ul,0x67452301ul,0x67452301ul,0x67452301ul,0x67452301ul,0x67452301ul,0x67452301ul,
+      0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,0xEFCDAB89ul,
+      0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,0x98BADCFEul,
+      0x10325476ul,0x10325476ul,0x10325476ul,0x10325476ul,0x10325476ul,0x10325476ul,0x10325476ul,0x10325476ul,
+      0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul,0xC3D2E1F0ul
+  };
+
+#define ROL(x,n) _mm256_or_si256( _mm256_slli_epi32(x, n) , _mm256_srli_epi32(x, 32 - n) )
+
+#ifdef WIN64
+
+#define not(x) _mm256_andnot_si256(x, _mm256_cmpeq_epi32(_mm256_setzero_si256(), _mm256_setzero_si256()))
+#define f1(x,y,z) _mm256_xor_si256(x, _mm256_xor_si256(y, z))
+#define f2(x,y,z) _mm256_or_si256(_mm256_and_si256(x,y),_mm256_andnot_si256(x,z))
+#define f3(x,y,z) _mm256_xor_si256(_mm256_or_si256(x,not(y)),z)
+#define f4(x,y,z) _mm256_or_si256(_mm256_and_si256(x,z),_mm256_andnot_si256(z,y))
+#define f5(x,y,z) _mm256_xor_si256(x,_mm256_or_si256(y,not(z)))
+
+#else
+
+#define f1(x,y,z) _mm256_xor_si256(x, _mm256_xor_si256(y, z))
+#define f2(x,y,z) _mm256_or_si256(_mm256_and_si256(x,y),_mm256_andnot_si256(x,z))
+#define f3(x,y,z) _mm256_xor_si256(_mm256_or_si256(x,~(y)),z)
+#define f4(x,y,z) _mm256_or_si256(_mm256_and_si256(x,z),_mm256_andnot_si256(z,y))
+#define f5(x,y,z) _mm256_xor_si256(x,_mm256_or_si256(y,~(z)))
+
+#endif
+
+
+#define add3(x0, x1, x2 ) _mm256_add_epi32(_mm256_add_epi32(x0, x1), x2)
+#define add4(x0, x1, x2, x3) _mm256_add_epi32(_mm256_add_epi32(x0, x1), _mm256_add_epi32(x2, x3))
+
+#define Round(a,b,c,d,e,f,x,k,r) \
+  u = add4(a,f,x,_mm256_set1_epi32(k)); \
+  a = _mm256_add_epi32(ROL(u, r),e); \
+  c = ROL(c, 10);
+
+#define R11(a,b,c,d,e,x,r) Round(a, b, c, d, e, f1(b, c, d), x, 0, r)
+#define R21(a,b,c,d,e,x,r) Round(a, b, c, d, e, f2(b, c, d), x, 0x5A827999ul, r)
+#define R31(a,b,c,d,e,x,r) Round(a, b, c, d, e, f3(b, c, d), x, 0x6ED9EBA1ul, r)
+#define R41(a,b,c,d,e,x,r) Round(a, b, c, d, e, f4(b, c, d), x, 0x8F1BBCDCul, r)
+#define R51(a,b,c,d,e,x,r) Round(a, b, c, d, e, f5(b, c, d), x, 0xA953FD4Eul, r)
+#define R12(a,b,c,d,e,x,r) Round(a, b, c, d, e, f5(b, c, d), x, 0x50A28BE6ul, r)
+#define R22(a,b,c,d,e,x,r) Round(a, b, c, d, e, f4(b, c, d), x, 0x5C4DD124ul, r)
+#define R32(a,b,c,d,e,x,r) Round(a, b, c, d, e, f3(b, c, d), x, 0x6D703EF3ul, r)
+#define R42(a,b,c,d,e,x,r) Round(a, b, c, d, e, f2(b, c, d), x, 0x7A6D76E9ul, r)
+#define R52(a,b,c,d,e,x,r) Round(a, b, c, d, e, f1(b, c, d), x, 0, r)
+
+// Rounds with a constant message word x (folded with k)
+#define RoundC(a,b,c,d,e,f,k,r) \
+  u = add3(a,f,_mm256_set1_epi32(k)); \
+  a = _mm256_add_epi32(ROL(u, r),e); \
+  c = ROL(c, 10);
+
+#define R11C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f1(b, c, d), (x), r)
+#define R21C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f2(b, c, d), (x) + 0x5A827999ul, r)
+#define R31C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f3(b, c, d), (x) + 0x6ED9EBA1ul, r)
+#define R41C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f4(b, c, d), (x) + 0x8F1BBCDCul, r)
+#define R51C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f5(b, c, d), (x) + 0xA953FD4Eul, r)
+#define R12C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f5(b, c, d), (x) + 0x50A28BE6ul, r)
+#define R22C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f4(b, c, d), (x) + 0x5C4DD124ul, r)
+#define R32C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f3(b, c, d), (x) + 0x6D703EF3ul, r)
+#define R42C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f2(b, c, d), (x) + 0x7A6D76E9ul, r)
+#define R52C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f1(b, c, d), (x), r)
+
+#define LOADW(i) _mm256_setr_epi32(*((uint32_t *)blk[0]+i),*((uint32_t *)blk[1]+i),*((uint32_t *)blk[2]+i),*((uint32_t *)blk[3]+i), \
+                                   *((uint32_t *)blk[4]+i),*((uint32_t *)blk[5]+i),*((uint32_t *)blk[6]+i),*((uint32_t *)blk[7]+i))
+
+  // Initialize RIPEMD-160 state
+  void Initialize(__m256i *s) {
+    memcpy(s, _init, sizeof(_init));
+  }
+
+  // Perform 8 RIPE in parallel using AVX2 (lane i holds message i)
+  void Transform(__m256i *s, __m256i *w) {
+
+    __m256i a1 = _mm256_load_si256(s + 0);
+    __m256i b1 = _mm256_load_si256(s + 1);
+    __m256i c1 = _mm256_load_si256(s + 2);
+    __m256i d1 = _mm256_load_si256(s + 3);
+    __m256i e1 = _mm256_load_si256(s + 4);
+    __m256i a2 = a1;
+    __m256i b2 = b1;
+    __m256i c2 = c1;
+    __m256i d2 = d1;
+    __m256i e2 = e1;
+    __m256i u;
+
+    R11(a1, b1, c1, d1, e1, w[0], 11);
+    R12(a2, b2, c2, d2, e2, w[5], 8);
+    R11(e1, a1, b1, c1, d1, w[1], 14);
+    R12(e2, a2, b2, c2, d2, w[14], 9);
+    R11(d1, e1, a1, b1, c1, w[2], 15);
+    R12(d2, e2, a2, b2, c2, w[7], 9);
+    R11(c1, d1, e1, a1, b1, w[3], 12);
+    R12(c2, d2, e2, a2, b2, w[0], 11);
+    R11(b1, c1, d1, e1, a1, w[4], 5);
+    R12(b2, c2, d2, e2, a2, w[9], 13);
+    R11(a1, b1, c1, d1, e1, w[5], 8);
+    R12(a2, b2, c2, d2, e2, w[2], 15);
+    R11(e1, a1, b1, c1, d1, w[6], 7);
+    R12(e2, a2, b2, c2, d2, w[11], 15);
+    R11(d1, e1, a1, b1, c1, w[7], 9);
+    R12(d2, e2, a2, b2, c2, w[4], 5);
+    R11(c1, d1, e1, a1, b1, w[8], 11);
+    R12(c2, d2, e2, a2, b2, w[13], 7);
+    R11(b1, c1, d1, e1, a1, w[9], 13);
+    R12(b2, c2, d2, e2, a2, w[6], 7);
+    R11(a1, b1, c1, d1, e1, w[10], 14);
+    R12(a2, b2, c2, d2, e2, w[15], 8);
+    R11(e1, a1, b1, c1, d1, w[11], 15);
+    R12(e2, a2, b2, c2, d2, w[8], 11);
+    R11(d1, e1, a1, b1, c1, w[12], 6);
+    R12(d2, e2, a2, b2, c2, w[1], 14);
+    R11(c1, d1, e1, a1, b1, w[13], 7);
+    R12(c2, d2, e2, a2, b2, w[10], 14);
+    R11(b1, c1, d1, e1, a1, w[14], 9);
+    R12(b2, c2, d2, e2, a2, w[3], 12);
+    R11(a1, b1, c1, d1, e1, w[15], 8);
+    R12(a2, b2, c2, d2, e2, w[12], 6);
+
+    R21(e1, a1, b1, c1, d1, w[7], 7);
+    R22(e2, a2, b2, c2, d2, w[6], 9);
+    R21(d1, e1, a1, b1, c1, w[4], 6);
+    R22(d2, e2, a2, b2, c2, w[11], 13);
+    R21(c1, d1, e1, a1, b1, w[13], 8);
+    R22(c2, d2, e2, a2, b2, w[3], 15);
+    R21(b1, c1, d1, e1, a1, w[1], 13);
+    R22(b2, c2, d2, e2, a2, w[7], 7);
+    R21(a1, b1, c1, d1, e1, w[10], 11);
+    R22(a2, b2, c2, d2, e2, w[0], 12);
+    R21(e1, a1, b1, c1, d1, w[6], 9);
+    R22(e2, a2, b2, c2, d2, w[13], 8);
+    R21(d1, e1, a1, b1, c1, w[15], 7);
+    R22(d2, e2, a2, b2, c2, w[5], 9);
+    R21(c1, d1, e1, a1, b1, w[3], 15);
+    R22(c2, d2, e2, a2, b2, w[10], 11);
+    R21(b1, c1, d1, e1, a1, w[12], 7);
+    R22(b2, c2, d2, e2, a2, w[14], 7);
+    R21(a1, b1, c1, d1, e1, w[0], 12);
+    R22(a2, b2, c2, d2, e2, w[15], 7);
+    R21(e1, a1, b1, c1, d1, w[9], 15);
+    R22(e2, a2, b2, c2, d2, w[8], 12);
+    R21(d1, e1, a1, b1, c1, w[5], 9);
+    R22(d2, e2, a2, b2, c2, w[12], 7);
+    R21(c1, d1, e1, a1, b1, w[2], 11);
+    R22(c2, d2, e2, a2, b2, w[4], 6);
+    R21(b1, c1, d1, e1, a1, w[14], 7);
+    R22(b2, c2, d2, e2, a2, w[9], 15);
+    R21(a1, b1, c1, d1, e1, w[11], 13);
+    R22(a2, b2, c2, d2, e2, w[1], 13);
+    R21(e1, a1, b1, c1, d1, w[8], 12);
+    R22(e2, a2, b2, c2, d2, w[2], 11);
+
+    R31(d1, e1, a1, b1, c1, w[3], 11);
+    R32(d2, e2, a2, b2, c2, w[15], 9);
+    R31(c1, d1, e1, a1, b1, w[10], 13);
+    R32(c2, d2, e2, a2, b2, w[5], 7);
+    R31(b1, c1, d1, e1, a1, w[14], 6);
+    R32(b2, c2, d2, e2, a2, w[1], 15);
+    R31(a1, b1, c1, d1, e1, w[4], 7);
+    R32(a2, b2, c2, d2, e2, w[3], 11);
+    R31(e1, a1, b1, c1, d1, w[9], 14);
+    R32(e2, a2, b2, c2, d2, w[7], 8);
+    R31(d1, e1, a1, b1, c1, w[15], 9);
+    R32(d2, e2, a2, b2, c2, w[14], 6);
+    R31(c1, d1, e1, a1, b1, w[8], 13);
+    R32(c2, d2, e2, a2, b2, w[6], 6);
+    R31(b1, c1, d1, e1, a1, w[1], 15);
+    R32(b2, c2, d2, e2, a2, w[9], 14);
+    R31(a1, b1, c1, d1, e1, w[2], 14);
+    R32(a2, b2, c2, d2, e2, w[11], 12);
+    R31(e1, a1, b1, c1, d1, w[7], 8);
+    R32(e2, a2, b2, c2, d2, w[8], 13);
+    R31(d1, e1, a1, b1, c1, w[0], 13);
+    R32(d2, e2, a2, b2, c2, w[12], 5);
+    R31(c1, d1, e1, a1, b1, w[6], 6);
+    R32(c2, d2, e2, a2, b2, w[2], 14);
+    R31(b1, c1, d1, e1, a1, w[13], 5);
+    R32(b2, c2, d2, e2, a2, w[10], 13);
+    R31(a1, b1, c1, d1, e1, w[11], 12);
+    R32(a2, b2, c2, d2, e2, w[0], 13);
+    R31(e1, a1, b1, c1, d1, w[5], 7);
+    R32(e2, a2, b2, c2, d2, w[4], 7);
+    R31(d1, e1, a1, b1, c1, w[12], 5);
+    R32(d2, e2, a2, b2, c2, w[13], 5);
+
+    R41(c1, d1, e1, a1, b1, w[1], 11);
+    R42(c2, d2, e2, a2, b2, w[8], 15);
+    R41(b1, c1, d1, e1, a1, w[9], 12);
+    R42(b2, c2, d2, e2, a2, w[6], 5);
+    R41(a1, b1, c1, d1, e1, w[11], 14);
+    R42(a2, b2, c2, d2, e2, w[4], 8);
+    R41(e1, a1, b1, c1, d1, w[10], 15);
+    R42(e2, a2, b2, c2, d2, w[1], 11);
+    R41(d1, e1, a1, b1, c1, w[0], 14);
+    R42(d2, e2, a2, b2, c2, w[3], 14);
+    R41(c1, d1, e1, a1, b1, w[8], 15);
+    R42(c2, d2, e2, a2, b2, w[11], 14);
+    R41(b1, c1, d1, e1, a1, w[12], 9);
+    R42(b2, c2, d2, e2, a2, w[15], 6);
+    R41(a1, b1, c1, d1, e1, w[4], 8);
+    R42(a2, b2, c2, d2, e2, w[0], 14);
+    R41(e1, a1, b1, c1, d1, w[13], 9);
+    R42(e2, a2, b2, c2, d2, w[5], 6);
+    R41(d1, e1, a1, b1, c1, w[3], 14);
+    R42(d2, e2, a2, b2, c2, w[12], 9);
+    R41(c1, d1, e1, a1, b1, w[7], 5);
+    R42(c2, d2, e2, a2, b2, w[2], 12);
+    R41(b1, c1, d1, e1, a1, w[15], 6);
+    R42(b2, c2, d2, e2, a2, w[13], 9);
+    R41(a1, b1, c1, d1, e1, w[14], 8);
+    R42(a2, b2, c2, d2, e2, w[9], 12);
+    R41(e1, a1, b1, c1, d1, w[5], 6);
+    R42(e2, a2, b2, c2, d2, w[7], 5);
+    R41(d1, e1, a1, b1, c1, w[6], 5);
+    R42(d2, e2, a2, b2, c2, w[10], 15);
+    R41(c1, d1, e1, a1, b1, w[2], 12);
+    R42(c2, d2, e2, a2, b2, w[14], 8);
+
+    R51(b1, c1, d1, e1, a1, w[4], 9);
+    R52(b2, c2, d2, e2, a2, w[12], 8);
+    R51(a1, b1, c1, d1, e1, w[0], 15);
+    R52(a2, b2, c2, d2, e2, w[15], 5);
+    R51(e1, a1, b1, c1, d1, w[5], 5);
+    R52(e2, a2, b2, c2, d2, w[10], 12);
+    R51(d1, e1, a1, b1, c1, w[9], 11);
+    R52(d2, e2, a2, b2, c2, w[4], 9);
+    R51(c1, d1, e1, a1, b1, w[7], 6);
+    R52(c2, d2, e2, a2, b2, w[1], 12);
+    R51(b1, c1, d1, e1, a1, w[12], 8);
+    R52(b2, c2, d2, e2, a2, w[5], 5);
+    R51(a1, b1, c1, d1, e1, w[2], 13);
+    R52(a2, b2, c2, d2, e2, w[8], 14);
+    R51(e1, a1, b1, c1, d1, w[10], 12);
+    R52(e2, a2, b2, c2, d2, w[7], 6);
+    R51(d1, e1, a1, b1, c1, w[14], 5);
+    R52(d2, e2, a2, b2, c2, w[6], 8);
+    R51(c1, d1, e1, a1, b1, w[1], 12);
+    R52(c2, d2, e2, a2, b2, w[2], 13);
+    R51(b1, c1, d1, e1, a1, w[3], 13);
+    R52(b2, c2, d2, e2, a2, w[13], 6);
+    R51(a1, b1, c1, d1, e1, w[8], 14);
+    R52(a2, b2, c2, d2, e2, w[14], 5);
+    R51(e1, a1, b1, c1, d1, w[11], 11);
+    R52(e2, a2, b2, c2, d2, w[0], 15);
+    R51(d1, e1, a1, b1, c1, w[6], 8);
+    R52(d2, e2, a2, b2, c2, w[3], 13);
+    R51(c1, d1, e1, a1, b1, w[15], 5);
+    R52(c2, d2, e2, a2, b2, w[9], 11);
+    R51(b1, c1, d1, e1, a1, w[13], 6);
+    R52(b2, c2, d2, e2, a2, w[11], 11);
+
+    __m256i t = s[0];
+    s[0] = add3(s[1],c1,d2);
+    s[1] = add3(s[2],d1,e2);
+    s[2] = add3(s[3],e1,a2);
+    s[3] = add3(s[4],a1,b2);
+    s[4] = add3(t,b1,c2);
+  }
+
+  // 32 bytes message (sha256 digest): words 8..15 hold the padding and the
+  // bit length, they are folded in the round constants
+  void Transform32(__m256i *s, __m256i *w) {
+
+    __m256i a1 = _mm256_load_si256(s + 0);
+    __m256i b1 = _mm256_load_si256(s + 1);
+    __m256i c1 = _mm256_load_si256(s + 2);
+    __m256i d1 = _mm256_load_si256(s + 3);
+    __m256i e1 = _mm256_load_si256(s + 4);
+    __m256i a2 = a1;
+    __m256i b2 = b1;
+    __m256i c2 = c1;
+    __m256i d2 = d1;
+    __m256i e2 = e1;
+    __m256i u;
+
+    R11(a1, b1, c1, d1, e1, w[0], 11);
+    R12(a2, b2, c2, d2, e2, w[5], 8);
+    R11(e1, a1, b1, c1, d1, w[1], 14);
+    R12C(e2, a2, b2, c2, d2, 0x100, 9);
+    R11(d1, e1, a1, b1, c1, w[2], 15);
+    R12(d2, e2, a2, b2, c2, w[7], 9);
+    R11(c1, d1, e1, a1, b1, w[3], 12);
+    R12(c2, d2, e2, a2, b2, w[0], 11);
+    R11(b1, c1, d1, e1, a1, w[4], 5);
+    R12C(b2, c2, d2, e2, a2, 0, 13);
+    R11(a1, b1, c1, d1, e1, w[5], 8);
+    R12(a2, b2, c2, d2, e2, w[2], 15);
+    R11(e1, a1, b1, c1, d1, w[6], 7);
+    R12C(e2, a2, b2, c2, d2, 0, 15);
+    R11(d1, e1, a1, b1, c1, w[7], 9);
+    R12(d2, e2, a2, b2, c2, w[4], 5);
+    R11C(c1, d1, e1, a1, b1, 0x80, 11);
+    R12C(c2, d2, e2, a2, b2, 0, 7);
+    R11C(b1, c1, d1, e1, a1, 0, 13);
+    R12(b2, c2, d2, e2, a2, w[6], 7);
+    R11C(a1, b1, c1, d1, e1, 0, 14);
+    R12C(a2, b2, c2, d2, e2, 0, 8);
+    R11C(e1, a1, b1, c1, d1, 0, 15);
+    R12C(e2, a2, b2, c2, d2, 0x80, 11);
+    R11C(d1, e1, a1, b1, c1, 0, 6);
+    R12(d2, e2, a2, b2, c2, w[1], 14);
+    R11C(c1, d1, e1, a1, b1, 0, 7);
+    R12C(c2, d2, e2, a2, b2, 0, 14);
+    R11C(b1, c1, d1, e1, a1, 0x100, 9);
+    R12(b2, c2, d2, e2, a2, w[3], 12);
+    R11C(a1, b1, c1, d1, e1, 0, 8);
+    R12C(a2, b2, c2, d2, e2, 0, 6);
+
+    R21(e1, a1, b1, c1, d1, w[7], 7);
+    R22(e2, a2, b2, c2, d2, w[6], 9);
+    R21(d1, e1, a1, b1, c1, w[4], 6);
+    R22C(d2, e2, a2, b2, c2, 0, 13);
+    R21C(c1, d1, e1, a1, b1, 0, 8);
+    R22(c2, d2, e2, a2, b2, w[3], 15);
+    R21(b1, c1, d1, e1, a1, w[1], 13);
+    R22(b2, c2, d2, e2, a2, w[7], 7);
+    R21C(a1, b1, c1, d1, e1, 0, 11);
+    R22(a2, b2, c2, d2, e2, w[0], 12);
+    R21(e1, a1, b1, c1, d1, w[6], 9);
+    R22C(e2, a2, b2, c2, d2, 0, 8);
+    R21C(d1, e1, a1, b1, c1, 0, 7);
+    R22(d2, e2, a2, b2, c2, w[5], 9);
+    R21(c1, d1, e1, a1, b1, w[3], 15);
+    R22C(c2, d2, e2, a2, b2, 0, 11);
+    R21C(b1, c1, d1, e1, a1, 0, 7);
+    R22C(b2, c2, d2, e2, a2, 0x100, 7);
+    R21(a1, b1, c1, d1, e1, w[0], 12);
+    R22C(a2, b2, c2, d2, e2, 0, 7);
+    R21C(e1, a1, b1, c1, d1, 0, 15);
+    R22C(e2, a2, b2, c2, d2, 0x80, 12);
+    R21(d1, e1, a1, b1, c1, w[5], 9);
+    R22C(d2, e2, a2, b2, c2, 0, 7);
+    R21(c1, d1, e1, a1, b1, w[2], 11);
+    R22(c2, d2, e2, a2, b2, w[4], 6);
+    R21C(b1, c1, d1, e1, a1, 0x100, 7);
+    R22C(b2, c2, d2, e2, a2, 0, 15);
+    R21C(a1, b1, c1, d1, e1, 0, 13);
+    R22(a2, b2, c2, d2, e2, w[1], 13);
+    R21C(e1, a1, b1, c1, d1, 0x80, 12);
+    R22(e2, a2, b2, c2, d2, w[2], 11);
+
+    R31(d1, e1, a1, b1, c1, w[3], 11);
+    R32C(d2, e2, a2, b2, c2, 0, 9);
+    R31C(c1, d1, e1, a1, b1, 0, 13);
+    R32(c2, d2, e2, a2, b2, w[5], 7);
+    R31C(b1, c1, d1, e1, a1, 0x100, 6);
+    R32(b2, c2, d2, e2, a2, w[1], 15);
+    R31(a1, b1, c1, d1, e1, w[4], 7);
+    R32(a2, b2, c2, d2, e2, w[3], 11);
+    R31C(e1, a1, b1, c1, d1, 0, 14);
+    R32(e2, a2, b2, c2, d2, w[7], 8);
+    R31C(d1, e1, a1, b1, c1, 0, 9);
+    R32C(d2, e2, a2, b2, c2, 0x100, 6);
+    R31C(c1, d1, e1, a1, b1, 0x80, 13);
+    R32(c2, d2, e2, a2, b2, w[6], 6);
+    R31(b1, c1, d1, e1, a1, w[1], 15);
+    R32C(b2, c2, d2, e2, a2, 0, 14);
+    R31(a1, b1, c1, d1, e1, w[2], 14);
+    R32C(a2, b2, c2, d2, e2, 0, 12);
+    R31(e1, a1, b1, c1, d1, w[7], 8);
+    R32C(e2, a2, b2, c2, d2, 0x80, 13);
+    R31(d1, e1, a1, b1, c1, w[0], 13);
+    R32C(d2, e2, a2, b2, c2, 0, 5);
+    R31(c1, d1, e1, a1, b1, w[6], 6);
+    R32(c2, d2, e2, a2, b2, w[2], 14);
+    R31C(b1, c1, d1, e1, a1, 0, 5);
+    R32C(b2, c2, d2, e2, a2, 0, 13);
+    R31C(a1, b1, c1, d1, e1, 0, 12);
+    R32(a2, b2, c2, d2, e2, w[0], 13);
+    R31(e1, a1, b1, c1, d1, w[5], 7);
+    R32(e2, a2, b2, c2, d2, w[4], 7);
+    R31C(d1, e1, a1, b1, c1, 0, 5);
+    R32C(d2, e2, a2, b2, c2, 0, 5);
+
+    R41(c1, d1, e1, a1, b1, w[1], 11);
+    R42C(c2, d2, e2, a2, b2, 0x80, 15);
+    R41C(b1, c1, d1, e1, a1, 0, 12);
+    R42(b2, c2, d2, e2, a2, w[6], 5);
+    R41C(a1, b1, c1, d1, e1, 0, 14);
+    R42(a2, b2, c2, d2, e2, w[4], 8);
+    R41C(e1, a1, b1, c1, d1, 0, 15);
+    R42(e2, a2, b2, c2, d2, w[1], 11);
+    R41(d1, e1, a1, b1, c1, w[0], 14);
+    R42(d2, e2, a2, b2, c2, w[3], 14);
+    R41C(c1, d1, e1, a1, b1, 0x80, 15);
+    R42C(c2, d2, e2, a2, b2, 0, 14);
+    R41C(b1, c1, d1, e1, a1, 0, 9);
+    R42C(b2, c2, d2, e2, a2, 0, 6);
+    R41(a1, b1, c1, d1, e1, w[4], 8);
+    R42(a2, b2, c2, d2, e2, w[0], 14);
+    R41C(e1, a1, b1, c1, d1, 0, 9);
+    R42(e2, a2, b2, c2, d2, w[5], 6);
+    R41(d1, e1, a1, b1, c1, w[3], 14);
+    R42C(d2, e2, a2, b2, c2, 0, 9);
+    R41(c1, d1, e1, a1, b1, w[7], 5);
+    R42(c2, d2, e2, a2, b2, w[2], 12);
+    R41C(b1, c1, d1, e1, a1, 0, 6);
+    R42C(b2, c2, d2, e2, a2, 0, 9);
+    R41C(a1, b1, c1, d1, e1, 0x100, 8);
+    R42C(a2, b2, c2, d2, e2, 0, 12);
+    R41(e1, a1, b1, c1, d1, w[5], 6);
+    R42(e2, a2, b2, c2, d2, w[7], 5);
+    R41(d1, e1, a1, b1, c1, w[6], 5);
+    R42C(d2, e2, a2, b2, c2, 0, 15);
+    R41(c1, d1, e1, a1, b1, w[2], 12);
+    R42C(c2, d2, e2, a2, b2, 0x100, 8);
+
+    R51(b1, c1, d1, e1, a1, w[4], 9);
+    R52C(b2, c2, d2, e2, a2, 0, 8);
+    R51(a1, b1, c1, d1, e1, w[0], 15);
+    R52C(a2, b2, c2, d2, e2, 0, 5);
+    R51(e1, a1, b1, c1, d1, w[5], 5);
+    R52C(e2, a2, b2, c2, d2, 0, 12);
+    R51C(d1, e1, a1, b1, c1, 0, 11);
+    R52(d2, e2, a2, b2, c2, w[4], 9);
+    R51(c1, d1, e1, a1, b1, w[7], 6);
+    R52(c2, d2, e2, a2, b2, w[1], 12);
+    R51C(b1, c1, d1, e1, a1, 0, 8);
+    R52(b2, c2, d2, e2, a2, w[5], 5);
+    R51(a1, b1, c1, d1, e1, w[2], 13);
+    R52C(a2, b2, c2, d2, e2, 0x80, 14);
+    R51C(e1, a1, b1, c1, d1, 0, 12);
+    R52(e2, a2, b2, c2, d2, w[7], 6);
+    R51C(d1, e1, a1, b1, c1, 0x100, 5);
+    R52(d2, e2, a2, b2, c2, w[6], 8);
+    R51(c1, d1, e1, a1, b1, w[1], 12);
+    R52(c2, d2, e2, a2, b2, w[2], 13);
+    R51(b1, c1, d1, e1, a1, w[3], 13);
+    R52C(b2, c2, d2, e2, a2, 0, 6);
+    R51C(a1, b1, c1, d1, e1, 0x80, 14);
+    R52C(a2, b2, c2, d2, e2, 0x100, 5);
+    R51C(e1, a1, b1, c1, d1, 0, 11);
+    R52(e2, a2, b2, c2, d2, w[0], 15);
+    R51(d1, e1, a1, b1, c1, w[6], 8);
+    R52(d2, e2, a2, b2, c2, w[3], 13);
+    R51C(c1, d1, e1, a1, b1, 0, 5);
+    R52C(c2, d2, e2, a2, b2, 0, 11);
+    R51C(b1, c1, d1, e1, a1, 0, 6);
+    R52C(b2, c2, d2, e2, a2, 0, 11);
+
+    __m256i t = s[0];
+    s[0] = add3(s[1],c1,d2);
+    s[1] = add3(s[2],d1,e2);
+    s[2] = add3(s[3],e1,a2);
+    s[3] = add3(s[4],a1,b2);
+    s[4] = add3(t,b1,c2);
+  }
+
+  // Load the 8 message blocks
+  void Transform(__m256i *s, uint8_t *blk[8]) {
+
+    __m256i w[16];
+    w[0] = LOADW(0);
+    w[1] = LOADW(1);
+    w[2] = LOADW(2);
+    w[3] = LOADW(3);
+    w[4] = LOADW(4);
+    w[5] = LOADW(5);
+    w[6] = LOADW(6);
+    w[7] = LOADW(7);
+    w[8] = LOADW(8);
+    w[9] = LOADW(9);
+    w[10] = LOADW(10);
+    w[11] = LOADW(11);
+    w[12] = LOADW(12);
+    w[13] = LOADW(13);
+    w[14] = LOADW(14);
+    w[15] = LOADW(15);
+    Transform(s, w);
+
+  }
+
+} // namespace ripemd160avx2
+
+#define DEPACK(d,i) \
+((uint32_t *)d)[0] = s32[0][i]; \
+((uint32_t *)d)[1] = s32[1][i]; \
+((uint32_t *)d)[2] = s32[2][i]; \
+((uint32_t *)d)[3] = s32[3][i]; \
+((uint32_t *)d)[4] = s32[4][i];
+
+static const uint64_t sizedesc_32 = 32 << 3;
+static const unsigned char pad[64] = { 0x80 };
+
+void ripemd160avx2_32(
+  unsigned char *i0, unsigned char *i1, unsigned char *i2, unsigned char *i3,
+  unsigned char *i4, unsigned char *i5, unsigned char *i6, unsigned char *i7,
+  unsigned char *d0, unsigned char *d1, unsigned char *d2, unsigned char *d3,
+  unsigned char *d4, unsigned char *d5, unsigned char *d6, unsigned char *d7) {
+
+  __m256i s[5];
+  uint8_t *bs[] = { i0,i1,i2,i3,i4,i5,i6,i7 };
+
+#ifdef WIN64
+  __declspec(align(32)) uint32_t s32[5][8];
+#else
+  uint32_t s32[5][8] __attribute__((aligned(32)));
+#endif
+
+  ripemd160avx2::Initialize(s);
+  for (int i = 0; i < 8; i++) {
+    memcpy(bs[i] + 32, pad, 24);
+    memcpy(bs[i] + 56, &sizedesc_32, 8);
+  }
+
+  ripemd160avx2::Transform(s, bs);
+
+  for (int i = 0; i < 5; i++)
+    _mm256_store_si256((__m256i *)s32[i], s[i]);
+
+  DEPACK(d0,0);
+  DEPACK(d1,1);
+  DEPACK(d2,2);
+  DEPACK(d3,3);
+  DEPACK(d4,4);
+  DEPACK(d5,5);
+  DEPACK(d6,6);
+  DEPACK(d7,7);
+
+}
+
+// Lane-transposed input/output: i[8][8] holds the sha256 digests as little
+// endian words (lane j = message j), d[5][8] receives the hash160 words.
+void ripemd160avx2_32_t(uint32_t *i, uint32_t *d) {
+
+  __m256i s[5];
+  __m256i w[8];
+  int j;
+
+  for (j = 0; j < 8; j++)
+    w[j] = _mm256_loadu_si256((__m256i *)(i + 8 * j));
+
+  ripemd160avx2::Initialize(s);
+  ripemd160avx2::Transform32(s, w);
+
+  for (j = 0; j < 5; j++)
+    _mm256_storeu_si256((__m256i *)(d + 8 * j), s[j]);
+
+}
@@ -81,6 +81,23 @@ namespace ripemd160sse {
 #define R42(a,b,c,d,e,x,r) Round(a, b, c, d, e, f2(b, c, d), x, 0x7A6D76E9ul, r)
 #define R52(a,b,c,d,e,x,r) Round(a, b, c, d, e, f1(b, c, d), x, 0, r)
 
+// Rounds with a constant message word x (folded with k)
+#define RoundC(a,b,c,d,e,f,k,r) \
+  u = add3(a,f,_mm_set1_epi32(k)); \
+  a = _mm_add_epi32(ROL(u, r),e); \
+  c = ROL(c, 10);
+
+#define R11C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f1(b, c, d), (x), r)
+#define R21C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f2(b, c, d), (x) + 0x5A827999ul, r)
+#define R31C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f3(b, c, d), (x) + 0x6ED9EBA1ul, r)
+#define R41C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f4(b, c, d), (x) + 0x8F1BBCDCul, r)
+#define R51C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f5(b, c, d), (x) + 0xA953FD4Eul, r)
+#define R12C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f5(b, c, d), (x) + 0x50A28BE6ul, r)
+#define R22C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f4(b, c, d), (x) + 0x5C4DD124ul, r)
+#define R32C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f3(b, c, d), (x) + 0x6D703EF3ul, r)
+#define R42C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f2(b, c, d), (x) + 0x7A6D76E9ul, r)
+#define R52C(a,b,c,d,e,x,r) RoundC(a, b, c, d, e, f1(b, c, d), (x), r)
+
 #define LOADW(i) _mm_set_epi32(*((uint32_t *)blk[0]+i),*((uint32_t *)blk[1]+i),*((uint32_t *)blk[2]+i),*((uint32_t *)blk[3]+i))
 
   // Initialize RIPEMD-160 state
@@ -89,7 +106,7 @@ namespace ripemd160sse {
   }
 
   // Perform 4 RIPE in parallel using SSE2
-  void Transform(__m128i *s, uint8_t *blk[4]) {
+  void Transform(__m128i *s, __m128i *w) {
 
     __m128i a1 = _mm_load_si128(s + 0);
     __m128i b1 = _mm_load_si128(s + 1);
@@ -102,25 +119,6 @@ namespace ripemd160sse {
     __m128i d2 = d1;
     __m128i e2 = e1;
     __m128i u;
-    __m128i w[16];
-
-
-    w[0] = LOADW(0);
-    w[1] = LOADW(1);
-    w[2] = LOADW(2);
-    w[3] = LOADW(3);
-    w[4] = LOADW(4);
-    w[5] = LOADW(5);
-    w[6] = LOADW(6);
-    w[7] = LOADW(7);
-    w[8] = LOADW(8);
-    w[9] = LOADW(9);
-    w[10] = LOADW(10);
-    w[11] = LOADW(11);
-    w[12] = LOADW(12);
-    w[13] = LOADW(13);
-    w[14] = LOADW(14);
-    w[15] = LOADW(15);
 
     R11(a1, b1, c1, d1, e1, w[0], 11);
     R12(a2, b2, c2, d2, e2, w[5], 8);
@@ -295,6 +293,219 @@ namespace ripemd160sse {
     s[4] = add3(t,b1,c2);
   }
 
+  // 32 bytes message (sha256 digest): words 8..15 hold the padding and the
+  // bit length, they are folded in the round constants
+  void Transform32(__m128i *s, __m128i *w) {
+
+    __m128i a1 = _mm_load_si128(s + 0);
+    __m128i b1 = _mm_load_si128(s + 1);
+    __m128i c1 = _mm_load_si128(s + 2);
+    __m128i d1 = _mm_load_si128(s + 3);
+    __m128i e1 = _mm_load_si128(s + 4);
+    __m128i a2 = a1;
+    __m128i b2 = b1;
+    __m128i c2 = c1;
+    __m128i d2 = d1;
+    __m128i e2 = e1;
+    __m128i u;
+
+    R11(a1, b1, c1, d1, e1, w[0], 11);
+    R12(a2, b2, c2, d2, e2, w[5], 8);
+    R11(e1, a1, b1, c1, d1, w[1], 14);
+    R12C(e2, a2, b2, c2, d2, 0x100, 9);
+    R11(d1, e1, a1, b1, c1, w[2], 15);
+    R12(d2, e2, a2, b2, c2, w[7], 9);
+    R11(c1, d1, e1, a1, b1, w[3], 12);
+    R12(c2, d2, e2, a2, b2, w[0], 11);
+    R11(b1, c1, d1, e1, a1, w[4], 5);
+    R12C(b2, c2, d2, e2, a2, 0, 13);
+    R11(a1, b1, c1, d1, e1, w[5], 8);
+    R12(a2, b2, c2, d2, e2, w[2], 15);
+    R11(e1, a1, b1, c1, d1, w[6], 7);
+    R12C(e2, a2, b2, c2, d2, 0, 15);
+    R11(d1, e1, a1, b1, c1, w[7], 9);
+    R12(d2, e2, a2, b2, c2, w[4], 5);
+    R11C(c1, d1, e1, a1, b1, 0x80, 11);
+    R12C(c2, d2, e2, a2, b2, 0, 7);
+    R11C(b1, c1, d1, e1, a1, 0, 13);
+    R12(b2, c2, d2, e2, a2, w[6], 7);
+    R11C(a1, b1, c1, d1, e1, 0, 14);
+    R12C(a2, b2, c2, d2, e2, 0, 8);
+    R11C(e1, a1, b1, c1, d1, 0, 15);
+    R12C(e2, a2, b2, c2, d2, 0x80, 11);
+    R11C(d1, e1, a1, b1, c1, 0, 6);
+    R12(d2, e2, a2, b2, c2, w[1], 14);
+    R11C(c1, d1, e1, a1, b1, 0, 7);
+    R12C(c2, d2, e2, a2, b2, 0, 14);
+    R11C(b1, c1, d1, e1, a1, 0x100, 9);
+    R12(b2, c2, d2, e2, a2, w[3], 12);
+    R11C(a1, b1, c1, d1, e1, 0, 8);
+    R12C(a2, b2, c2, d2, e2, 0, 6);
+
+    R21(e1, a1, b1, c1, d1, w[7], 7);
+    R22(e2, a2, b2, c2, d2, w[6], 9);
+    R21(d1, e1, a1, b1, c1, w[4], 6);
+    R22C(d2, e2, a2, b2, c2, 0, 13);
+    R21C(c1, d1, e1, a1, b1, 0, 8);
+    R22(c2, d2, e2, a2, b2, w[3], 15);
+    R21(b1, c1, d1, e1, a1, w[1], 13);
+    R22(b2, c2, d2, e2, a2, w[7], 7);
+    R21C(a1, b1, c1, d1, e1, 0, 11);
+    R22(a2, b2, c2, d2, e2, w[0], 12);
+    R21(e1, a1, b1, c1, d1, w[6], 9);
+    R22C(e2, a2, b2, c2, d2, 0, 8);
+    R21C(d1, e1, a1, b1, c1, 0, 7);
+    R22(d2, e2, a2, b2, c2, w[5], 9);
+    R21(c1, d1, e1, a1, b1, w[3], 15);
+    R22C(c2, d2, e2, a2, b2, 0, 11);
+    R21C(b1, c1, d1, e1, a1, 0, 7);
+    R22C(b2, c2, d2, e2, a2, 0x100, 7);
+    R21(a1, b1, c1, d1, e1, w[0], 12);
+    R22C(a2, b2, c2, d2, e2, 0, 7);
+    R21C(e1, a1, b1, c1, d1, 0, 15);
+    R22C(e2, a2, b2, c2, d2, 0x80, 12);
+    R21(d1, e1, a1, b1, c1, w[5], 9);
+    R22C(d2, e2, a2, b2, c2, 0, 7);
+    R21(c1, d1, e1, a1, b1, w[2], 11);
+    R22(c2, d2, e2, a2, b2, w[4], 6);
+    R21C(b1, c1, d1, e1, a1, 0x100, 7);
+    R22C(b2, c2, d2, e2, a2, 0, 15);
+    R21C(a1, b1, c1, d1, e1, 0, 13);
+    R22(a2, b2, c2, d2, e2, w[1], 13);
+    R21C(e1, a1, b1, c1, d1, 0x80, 12);
+    R22(e2, a2, b2, c2, d2, w[2], 11);
+
+    R31(d1, e1, a1, b1, c1, w[3], 11);
+    R32C(d2, e2, a2, b2, c2, 0, 9);
+    R31C(c1, d1, e1, a1, b1, 0, 13);
+    R32(c2, d2, e2, a2, b2, w[5], 7);
+    R31C(b1, c1, d1, e1, a1, 0x100, 6);
+    R32(b2, c2, d2, e2, a2, w[1], 15);
+    R31(a1, b1, c1, d1, e1, w[4], 7);
+    R32(a2, b2, c2, d2, e2, w[3], 11);
+    R31C(e1, a1, b1, c1, d1, 0, 14);
+    R32(e2, a2, b2, c2, d2, w[7], 8);
+    R31C(d1, e1, a1, b1, c1, 0, 9);
+    R32C(d2, e2, a2, b2, c2, 0x100, 6);
+    R31C(c1, d1, e1, a1, b1, 0x80, 13);
+    R32(c2, d2, e2, a2, b2, w[6], 6);
+    R31(b1, c1, d1, e1, a1, w[1], 15);
+    R32C(b2, c2, d2, e2, a2, 0, 14);
+    R31(a1, b1, c1, d1, e1, w[2], 14);
+    R32C(a2, b2, c2, d2, e2, 0, 12);
+    R31(e1, a1, b1, c1, d1, w[7], 8);
+    R32C(e2, a2, b2, c2, d2, 0x80, 13);
+    R31(d1, e1, a1, b1, c1, w[0], 13);
+    R32C(d2, e2, a2, b2, c2, 0, 5);
+    R31(c1, d1, e1, a1, b1, w[6], 6);
+    R32(c2, d2, e2, a2, b2, w[2], 14);
+    R31C(b1, c1, d1, e1, a1, 0, 5);
+    R32C(b2, c2, d2, e2, a2, 0, 13);
+    R31C(a1, b1, c1, d1, e1, 0, 12);
+    R32(a2, b2, c2, d2, e2, w[0], 13);
+    R31(e1, a1, b1, c1, d1, w[5], 7);
+    R32(e2, a2, b2, c2, d2, w[4], 7);
+    R31C(d1, e1, a1, b1, c1, 0, 5);
+    R32C(d2, e2, a2, b2, c2, 0, 5);
+
+    R41(c1, d1, e1, a1, b1, w[1], 11);
+    R42C(c2, d2, e2, a2, b2, 0x80, 15);
+    R41C(b1, c1, d1, e1, a1, 0, 12);
+    R42(b2, c2, d2, e2, a2, w[6], 5);
+    R41C(a1, b1, c1, d1, e1, 0, 14);
+    R42(a2, b2, c2, d2, e2, w[4], 8);
+    R41C(e1, a1, b1, c1, d1, 0, 15);
+    R42(e2, a2, b2, c2, d2, w[1], 11);
+    R41(d1, e1, a1, b1, c1, w[0], 14);
+    R42(d2, e2, a2, b2, c2, w[3], 14);
+    R41C(c1, d1, e1, a1, b1, 0x80, 15);
+    R42C(c2, d2, e2, a2, b2, 0, 14);
+    R41C(b1, c1, d1, e1, a1, 0, 9);
+    R42C(b2, c2, d2, e2, a2, 0, 6);
+    R41(a1, b1, c1, d1, e1, w[4], 8);
+    R42(a2, b2, c2, d2, e2, w[0], 14);
+    R41C(e1, a1, b1, c1, d1, 0, 9);
+    R42(e2, a2, b2, c2, d2, w[5], 6);
+    R41(d1, e1, a1, b1, c1, w[3], 14);
+    R42C(d2, e2, a2, b2, c2, 0, 9);
+    R41(c1, d1, e1, a1, b1, w[7], 5);
+    R42(c2, d2, e2, a2, b2, w[2], 12);
+    R41C(b1, c1, d1, e1, a1, 0, 6);
+    R42C(b2, c2, d2, e2, a2, 0, 9);
+    R41C(a1, b1, c1, d1, e1, 0x100, 8);
+    R42C(a2, b2, c2, d2, e2, 0, 12);
+    R41(e1, a1, b1, c1, d1, w[5], 6);
+    R42(e2, a2, b2, c2, d2, w[7], 5);
+    R41(d1, e1, a1, b1, c1, w[6], 5);
+    R42C(d2, e2, a2, b2, c2, 0, 15);
+    R41(c1, d1, e1, a1, b1, w[2], 12);
+    R42C(c2, d2, e2, a2, b2, 0x100, 8);
+
+    R51(b1, c1, d1, e1, a1, w[4], 9);
+    R52C(b2, c2, d2, e2, a2, 0, 8);
+    R51(a1, b1, c1, d1, e1, w[0], 15);
+    R52C(a2, b2, c2, d2, e2, 0, 5);
+    R51(e1, a1, b1, c1, d1, w[5], 5);
+    R52C(e2, a2, b2, c2, d2, 0, 12);
+    R51C(d1, e1, a1, b1, c1, 0, 11);
+    R52(d2, e2, a2, b2, c2, w[4], 9);
+    R51(c1, d1, e1, a1, b1, w[7], 6);
+    R52(c2, d2, e2, a2, b2, w[1], 12);
+    R51C(b1, c1, d1, e1, a1, 0, 8);
+    R52(b2, c2, d2, e2, a2, w[5], 5);
+    R51(a1, b1, c1, d1, e1, w[2], 13);
+    R52C(a2, b2, c2, d2, e2, 0x80, 14);
+    R51C(e1, a1, b1, c1, d1, 0, 12);
+    R52(e2, a2, b2, c2, d2, w[7], 6);
+    R51C(d1, e1, a1, b1, c1, 0x100, 5);
+    R52(d2, e2, a2, b2, c2, w[6], 8);
+    R51(c1, d1, e1, a1, b1, w[1], 12);
+    R52(c2, d2, e2, a2, b2, w[2], 13);
+    R51(b1, c1, d1, e1, a1, w[3], 13);
+    R52C(b2, c2, d2, e2, a2, 0, 6);
+    R51C(a1, b1, c1, d1, e1, 0x80, 14);
+    R52C(a2, b2, c2, d2, e2, 0x100, 5);
+    R51C(e1, a1, b1, c1, d1, 0, 11);
+    R52(e2, a2, b2, c2, d2, w[0], 15);
+    R51(d1, e1, a1, b1, c1, w[6], 8);
+    R52(d2, e2, a2, b2, c2, w[3], 13);
+    R51C(c1, d1, e1, a1, b1, 0, 5);
+    R52C(c2, d2, e2, a2, b2, 0, 11);
+    R51C(b1, c1, d1, e1, a1, 0, 6);
+    R52C(b2, c2, d2, e2, a2, 0, 11);
+
+    __m128i t = s[0];
+    s[0] = add3(s[1],c1,d2);
+    s[1] = add3(s[2],d1,e2);
+    s[2] = add3(s[3],e1,a2);
+    s[3] = add3(s[4],a1,b2);
+    s[4] = add3(t,b1,c2);
+  }
+
+  // Load the 4 message blocks
+  void Transform(__m128i *s, uint8_t *blk[4]) {
+
+    __m128i w[16];
+    w[0] = LOADW(0);
+    w[1] = LOADW(1);
+    w[2] = LOADW(2);
+    w[3] = LOADW(3);
+    w[4] = LOADW(4);
+    w[5] = LOADW(5);
+    w[6] = LOADW(6);
+    w[7] = LOADW(7);
+    w[8] = LOADW(8);
+    w[9] = LOADW(9);
+    w[10] = LOADW(10);
+    w[11] = LOADW(11);
+    w[12] = LOADW(12);
+    w[13] = LOADW(13);
+    w[14] = LOADW(14);
+    w[15] = LOADW(15);
+    Transform(s, w);
+
+  }
+
 } // namespace ripemd160sse
 
 #ifdef WIN64
@@ -360,6 +571,25 @@ void ripemd160sse_32(
 
 }
 
+// Lane-transposed input/output: i[8][4] holds the sha256 digests as little
+// endian words (lane j = message j), d[5][4] receives the hash160 words.
+void ripemd160sse_32_t(uint32_t *i, uint32_t *d) {
+
+  __m128i s[5];
+  __m128i w[8];
+  int j;
+
+  for (j = 0; j < 8; j++)
+    w[j] = _mm_loadu_si128((__m128i *)(i + 4 * j));
+
+  ripemd160sse::Initialize(s);
+  ripemd160sse::Transform32(s, w);
+
+  for (j = 0; j < 5; j++)
+    _mm_storeu_si128((__m128i *)(d + 4 * j), s[j]);
+
+}
+
 void ripemd160sse_test() {
 
   unsigned char h0[20];
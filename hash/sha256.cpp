@@ -17,6 +17,9 @@
 
 #include <string.h>
 #include "sha256.h"
+#ifdef WIN64
+#include <intrin.h>
+#endif
 
 #define BSWAP
 
@@ -351,6 +354,32 @@ namespace _sha256
 
 } // namespace sha256
 
+// Use the SHA extensions when available (see sha256_init())
+static bool useShaNI = false;
+
+void sha256_init() {
+
+	int cpuiddata[4];
+	useShaNI = false;
+
+	__cpuid(cpuiddata, 0x00000000);
+	if (cpuiddata[0] < 7)
+		return;
+
+	// SSSE3 and SSE4.1 are needed for the state shuffle
+	__cpuid(cpuiddata, 0x00000001);
+	if (((cpuiddata[2] >> 9) & 0x1) == 0 || ((cpuiddata[2] >> 19) & 0x1) == 0)
+		return;
+
+	__cpuidex(cpuiddata, 7, 0);
+	useShaNI = ((cpuiddata[1] >> 29) & 0x1) == 1;
+
+}
+
+bool sha256_shani_enabled() {
+	return useShaNI;
+}
+
 
 ////// SHA-256
 
@@ -391,9 +420,19 @@ void CSHA256::Write(const unsigned char* data, size_t len)
 		memcpy(buf + bufsize, data, 64 - bufsize);
 		bytes += 64 - bufsize;
 		data += 64 - bufsize;
-		_sha256::Transform(s, buf);
+		if (useShaNI)
+			sha256shani_transform(s, buf, 1);
+		else
+			_sha256::Transform(s, buf);
 		bufsize = 0;
 	}
+	if (useShaNI && end >= data + 64) {
+		// Process full chunks directly from the source.
+		int nbBlock = (int)((end - data) / 64);
+		sha256shani_transform(s, data, nbBlock);
+		bytes += 64 * nbBlock;
+		data += 64 * nbBlock;
+	}
 	while (end >= data + 64) {
 		// Process full chunks directly from the source.
 		_sha256::Transform(s, data);
@@ -442,7 +481,10 @@ void sha256_33(uint8_t* input, unsigned char* digest) {
 	_sha256::Initialize(s);
 	memcpy(input + 33, _sha256::pad, 23);
 	memcpy(input + 56, sizedesc_33, 8);
-	_sha256::Transform(s, input);
+	if (useShaNI)
+		sha256shani_transform(s, input, 1);
+	else
+		_sha256::Transform(s, input);
 
 	WRITEBE32(digest, s[0]);
 	WRITEBE32(digest + 4, s[1]);
@@ -464,8 +506,12 @@ void sha256_65(uint8_t* input, unsigned char* digest) {
 	memcpy(input + 120, sizedesc_65, 8);
 
 	_sha256::Initialize(s);
-	_sha256::Transform(s, input);
-	_sha256::Transform(s, input + 64);
+	if (useShaNI) {
+		sha256shani_transform(s, input, 2);
+	} else {
+		_sha256::Transform(s, input);
+		_sha256::Transform(s, input + 64);
+	}
 
 	WRITEBE32(digest, s[0]);
 	WRITEBE32(digest + 4, s[1]);
@@ -478,6 +524,16 @@ void sha256_65(uint8_t* input, unsigned char* digest) {
 
 }
 
+#define WRITEDIGEST(digest,s) \
+WRITEBE32(digest, s[0]); \
+WRITEBE32(digest + 4, s[1]); \
+WRITEBE32(digest + 8, s[2]); \
+WRITEBE32(digest + 12, s[3]); \
+WRITEBE32(digest + 16, s[4]); \
+WRITEBE32(digest + 20, s[5]); \
+WRITEBE32(digest + 24, s[6]); \
+WRITEBE32(digest + 28, s[7]);
+
 void sha256_checksum(const unsigned char* input, const unsigned char* inputend, unsigned int* chksum) {
 
 	uint32_t s[8];
@@ -486,11 +542,74 @@ void sha256_checksum(const unsigned char* input, const unsigned char* inputend,
 	memcpy(b, input, length);
 	memcpy(b + length, _sha256::pad, 56 - length);
 	WRITEBE64(b + 56, length << 3);
-	_sha256::Transform2(s, b);
+	if (useShaNI) {
+		// SHA256(SHA256(input))[0]
+		_sha256::Initialize(s);
+		sha256shani_transform(s, b, 1);
+		WRITEDIGEST(b, s);
+		memcpy(b + 32, _sha256::pad, 24);
+		memcpy(b + 56, sizedesc_32, 8);
+		_sha256::Initialize(s);
+		sha256shani_transform(s, b, 1);
+	} else {
+		_sha256::Transform2(s, b);
+	}
 	WRITEBE32(chksum, s[0]);
 
 }
 
+// 2 messages at a time, interleaved when the SHA extensions are available
+
+void sha256_33_2w(uint8_t* i0, uint8_t* i1, unsigned char* d0, unsigned char* d1) {
+
+	if (!useShaNI) {
+		sha256_33(i0, d0);
+		sha256_33(i1, d1);
+		return;
+	}
+
+	uint32_t s0[8];
+	uint32_t s1[8];
+
+	memcpy(i0 + 33, _sha256::pad, 23);
+	memcpy(i0 + 56, sizedesc_33, 8);
+	memcpy(i1 + 33, _sha256::pad, 23);
+	memcpy(i1 + 56, sizedesc_33, 8);
+
+	_sha256::Initialize(s0);
+	_sha256::Initialize(s1);
+	sha256shani_transform_2w(s0, s1, i0, i1, 1);
+
+	WRITEDIGEST(d0, s0);
+	WRITEDIGEST(d1, s1);
+
+}
+
+void sha256_65_2w(uint8_t* i0, uint8_t* i1, unsigned char* d0, unsigned char* d1) {
+
+	if (!useShaNI) {
+		sha256_65(i0, d0);
+		sha256_65(i1, d1);
+		return;
+	}
+
+	uint32_t s0[8];
+	uint32_t s1[8];
+
+	memcpy(i0 + 65, _sha256::pad, 55);
+	memcpy(i0 + 120, sizedesc_65, 8);
+	memcpy(i1 + 65, _sha256::pad, 55);
+	memcpy(i1 + 120, sizedesc_65, 8);
+
+	_sha256::Initialize(s0);
+	_sha256::Initialize(s1);
+	sha256shani_transform_2w(s0, s1, i0, i1, 2);
+
+	WRITEDIGEST(d0, s0);
+	WRITEDIGEST(d1, s1);
+
+}
+
 std::string sha256_hex(unsigned char* digest) {
 
 	char buf[2 * 32 + 1];
@@ -23,12 +23,39 @@ void sha256(const uint8_t *input,int length, uint8_t *digest);
 void sha256_33(uint8_t *input, uint8_t *digest);
 void sha256_65(uint8_t *input, uint8_t *digest);
 void sha256_checksum(const unsigned char* input, const unsigned char* inputend, unsigned int* chksum);
+void sha256_33_2w(uint8_t *i0, uint8_t *i1, uint8_t *d0, uint8_t *d1);
+void sha256_65_2w(uint8_t *i0, uint8_t *i1, uint8_t *d0, uint8_t *d1);
+void sha256_init();
+bool sha256_shani_enabled();
+void sha256shani_transform(uint32_t *s, const uint8_t *chunk, int nbBlock);
+void sha256shani_transform_2w(uint32_t *s0, uint32_t *s1, const uint8_t *c0, const uint8_t *c1, int nbBlock);
 void sha256sse_1B(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
   uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3);
 void sha256sse_2B(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
   uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3);
 void sha256sse_checksum(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
   uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3);
+void sha256avx2_1B(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
+  uint32_t *i4, uint32_t *i5, uint32_t *i6, uint32_t *i7,
+  uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3,
+  uint8_t *d4, uint8_t *d5, uint8_t *d6, uint8_t *d7);
+void sha256avx2_2B(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
+  uint32_t *i4, uint32_t *i5, uint32_t *i6, uint32_t *i7,
+  uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3,
+  uint8_t *d4, uint8_t *d5, uint8_t *d6, uint8_t *d7);
+void sha256avx512_1B(uint32_t *i[16], uint8_t *d[16]);
+void sha256avx512_2B(uint32_t *i[16], uint8_t *d[16]);
+void sha256sse_33_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3, uint32_t *d);
+void sha256sse_65_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3, uint32_t *d);
+void sha256sse_p2sh_t(uint32_t *h, uint32_t *d);
+void sha256avx2_33_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
+  uint32_t *i4, uint32_t *i5, uint32_t *i6, uint32_t *i7, uint32_t *d);
+void sha256avx2_65_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
+  uint32_t *i4, uint32_t *i5, uint32_t *i6, uint32_t *i7, uint32_t *d);
+void sha256avx2_p2sh_t(uint32_t *h, uint32_t *d);
+void sha256avx512_33_t(uint32_t *i[16], uint32_t *d);
+void sha256avx512_65_t(uint32_t *i[16], uint32_t *d);
+void sha256avx512_p2sh_t(uint32_t *h, uint32_t *d);
 std::string sha256_hex(unsigned char *digest);
 void sha256sse_test();
 
@@ -0,0 +1,790 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sha256.h"
+#include <immintrin.h>
+#include <string.h>
+#include <stdint.h>
+
+namespace _sha256avx512
+{
+
+
+#ifdef WIN64
+  static const __declspec(align(64)) uint32_t _init[] = {
+#else
+  static const uint32_t _init[] __attribute__ ((aligned (64))) = {
+#endif
+      0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,0x6a09e667,
+      0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,0xbb67ae85,
+      0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,0x3c6ef372,
+      0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,0xa54ff53a,
+      0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,0x510e527f,
+      0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,0x9b05688c,
+      0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,0x1f83d9ab,
+      0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19,0x5be0cd19
+  };
+
+// AVX-512 has native rotates and 3 inputs logic (vpternlogd)
+#define Maj(b,c,d) _mm512_ternarylogic_epi32(b, c, d, 0xE8)
+#define Ch(b,c,d)  _mm512_ternarylogic_epi32(b, c, d, 0xCA)
+#define ROR(x,n)   _mm512_ror_epi32(x, n)
+#define SHR(x,n)   _mm512_srli_epi32(x, n)
+#define XOR3(x,y,z) _mm512_ternarylogic_epi32(x, y, z, 0x96)
+
+  /* SHA256 Functions */
+#define	S0(x) XOR3(ROR((x), 2), ROR((x), 13), ROR((x), 22))
+#define	S1(x) XOR3(ROR((x), 6), ROR((x), 11), ROR((x), 25))
+#define	s0(x) XOR3(ROR((x), 7), ROR((x), 18), SHR((x), 3))
+#define	s1(x) XOR3(ROR((x), 17), ROR((x), 19), SHR((x), 10))
+
+#define add4(x0, x1, x2, x3) _mm512_add_epi32(_mm512_add_epi32(x0, x1), _mm512_add_epi32(x2, x3))
+#define add3(x0, x1, x2 ) _mm512_add_epi32(_mm512_add_epi32(x0, x1), x2)
+#define add5(x0, x1, x2, x3, x4) _mm512_add_epi32(add3(x0, x1, x2), _mm512_add_epi32(x3, x4))
+
+
+#define	Round(a, b, c, d, e, f, g, h, i, w)                    \
+    T1 = add5(h, S1(e), Ch(e, f, g), _mm512_set1_epi32(i), w); \
+    d = _mm512_add_epi32(d, T1);                               \
+    T2 = _mm512_add_epi32(S0(a), Maj(a, b, c));                \
+    h = _mm512_add_epi32(T1, T2);
+
+// Round with a constant message word, k = K[i] + w[i]
+#define	RoundC(a, b, c, d, e, f, g, h, k)                       \
+    T1 = add4(h, S1(e), Ch(e, f, g), _mm512_set1_epi32(k));    \
+    d = _mm512_add_epi32(d, T1);                               \
+    T2 = _mm512_add_epi32(S0(a), Maj(a, b, c));                \
+    h = _mm512_add_epi32(T1, T2);
+
+#define WMIX() \
+  w0 = add4(s1(w14), w9, s0(w1), w0); \
+  w1 = add4(s1(w15), w10, s0(w2), w1); \
+  w2 = add4(s1(w0), w11, s0(w3), w2); \
+  w3 = add4(s1(w1), w12, s0(w4), w3); \
+  w4 = add4(s1(w2), w13, s0(w5), w4); \
+  w5 = add4(s1(w3), w14, s0(w6), w5); \
+  w6 = add4(s1(w4), w15, s0(w7), w6); \
+  w7 = add4(s1(w5), w0, s0(w8), w7); \
+  w8 = add4(s1(w6), w1, s0(w9), w8); \
+  w9 = add4(s1(w7), w2, s0(w10), w9); \
+  w10 = add4(s1(w8), w3, s0(w11), w10); \
+  w11 = add4(s1(w9), w4, s0(w12), w11); \
+  w12 = add4(s1(w10), w5, s0(w13), w12); \
+  w13 = add4(s1(w11), w6, s0(w14), w13); \
+  w14 = add4(s1(w12), w7, s0(w15), w14); \
+  w15 = add4(s1(w13), w8, s0(w0), w15);
+
+  // Transpose a 16x16 matrix of 32bit words (4 shuffle stages)
+  static inline void Transpose(__m512i *r) {
+
+    __m512i t[16];
+    int i;
+
+    for (i = 0; i < 16; i += 2) {
+      t[i] = _mm512_unpacklo_epi32(r[i], r[i + 1]);
+      t[i + 1] = _mm512_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (i = 0; i < 16; i += 4) {
+      r[i] = _mm512_unpacklo_epi64(t[i], t[i + 2]);
+      r[i + 1] = _mm512_unpackhi_epi64(t[i], t[i + 2]);
+      r[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+      r[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    // r[4p+m] now holds, in its 128bit lane q, word 4q+m of rows 4p..4p+3
+    for (i = 0; i < 4; i++) {
+      t[i] = _mm512_shuffle_i32x4(r[i], r[4 + i], 0x88);
+      t[4 + i] = _mm512_shuffle_i32x4(r[i], r[4 + i], 0xDD);
+      t[8 + i] = _mm512_shuffle_i32x4(r[8 + i], r[12 + i], 0x88);
+      t[12 + i] = _mm512_shuffle_i32x4(r[8 + i], r[12 + i], 0xDD);
+    }
+    for (i = 0; i < 4; i++) {
+      r[i] = _mm512_shuffle_i32x4(t[i], t[8 + i], 0x88);
+      r[4 + i] = _mm512_shuffle_i32x4(t[4 + i], t[12 + i], 0x88);
+      r[8 + i] = _mm512_shuffle_i32x4(t[i], t[8 + i], 0xDD);
+      r[12 + i] = _mm512_shuffle_i32x4(t[4 + i], t[12 + i], 0xDD);
+    }
+
+  }
+
+  // Initialise state
+  void Initialize(__m512i *s) {
+    memcpy(s, _init, sizeof(_init));
+  }
+
+  // Perform 16 SHA in parallel using AVX-512 (lane i holds message i)
+  void Transform(__m512i *s, uint32_t *bi[16], int blk)
+  {
+    __m512i a,b,c,d,e,f,g,h;
+    __m512i w0, w1, w2, w3, w4, w5, w6, w7;
+    __m512i w8, w9, w10, w11, w12, w13, w14, w15;
+    __m512i T1, T2;
+    __m512i r[16];
+
+    a = _mm512_load_si512(s + 0);
+    b = _mm512_load_si512(s + 1);
+    c = _mm512_load_si512(s + 2);
+    d = _mm512_load_si512(s + 3);
+    e = _mm512_load_si512(s + 4);
+    f = _mm512_load_si512(s + 5);
+    g = _mm512_load_si512(s + 6);
+    h = _mm512_load_si512(s + 7);
+
+    for (int i = 0; i < 16; i++)
+      r[i] = _mm512_loadu_si512(bi[i] + 16 * blk);
+    Transpose(r);
+
+    w0 = r[0];
+    w1 = r[1];
+    w2 = r[2];
+    w3 = r[3];
+    w4 = r[4];
+    w5 = r[5];
+    w6 = r[6];
+    w7 = r[7];
+    w8 = r[8];
+    w9 = r[9];
+    w10 = r[10];
+    w11 = r[11];
+    w12 = r[12];
+    w13 = r[13];
+    w14 = r[14];
+    w15 = r[15];
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    Round(h, a, b, c, d, e, f, g, 0x71374491, w1);
+    Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w2);
+    Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x3956C25B, w4);
+    Round(d, e, f, g, h, a, b, c, 0x59F111F1, w5);
+    Round(c, d, e, f, g, h, a, b, 0x923F82A4, w6);
+    Round(b, c, d, e, f, g, h, a, 0xAB1C5ED5, w7);
+    Round(a, b, c, d, e, f, g, h, 0xD807AA98, w8);
+    Round(h, a, b, c, d, e, f, g, 0x12835B01, w9);
+    Round(g, h, a, b, c, d, e, f, 0x243185BE, w10);
+    Round(f, g, h, a, b, c, d, e, 0x550C7DC3, w11);
+    Round(e, f, g, h, a, b, c, d, 0x72BE5D74, w12);
+    Round(d, e, f, g, h, a, b, c, 0x80DEB1FE, w13);
+    Round(c, d, e, f, g, h, a, b, 0x9BDC06A7, w14);
+    Round(b, c, d, e, f, g, h, a, 0xC19BF174, w15);
+
+    WMIX()
+
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w0);
+    Round(h, a, b, c, d, e, f, g, 0xEFBE4786, w1);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w2);
+    Round(f, g, h, a, b, c, d, e, 0x240CA1CC, w3);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w4);
+    Round(d, e, f, g, h, a, b, c, 0x4A7484AA, w5);
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w6);
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w7);
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w8);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w9);
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w10);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w11);
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w12);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w13);
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w14);
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w15);
+
+    WMIX()
+
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w0);
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w1);
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w2);
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w3);
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w4);
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w5);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w6);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w7);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w8);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w9);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w10);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w11);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w12);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w13);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w14);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w15);
+
+    WMIX()
+
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w0);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w1);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w2);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w4);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w5);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w6);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w7);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w8);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w9);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w10);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w11);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w12);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w13);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w14);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w15);
+
+    s[0] = _mm512_add_epi32(a, s[0]);
+    s[1] = _mm512_add_epi32(b, s[1]);
+    s[2] = _mm512_add_epi32(c, s[2]);
+    s[3] = _mm512_add_epi32(d, s[3]);
+    s[4] = _mm512_add_epi32(e, s[4]);
+    s[5] = _mm512_add_epi32(f, s[5]);
+    s[6] = _mm512_add_epi32(g, s[6]);
+    s[7] = _mm512_add_epi32(h, s[7]);
+
+  }
+
+  // Transpose the state and store big endian digests
+  void Unpack(__m512i *s, unsigned char *d[16]) {
+
+    __m512i r[16];
+    int i;
+
+    // Byte swap: (ror8 & 0xFF00FF00) | (rol8 & 0x00FF00FF)
+    __m512i mask = _mm512_set1_epi32(0xFF00FF00);
+    for (i = 0; i < 8; i++)
+      r[i] = _mm512_ternarylogic_epi32(mask, _mm512_ror_epi32(s[i], 8), _mm512_rol_epi32(s[i], 8), 0xCA);
+    for (; i < 16; i++)
+      r[i] = _mm512_setzero_si512();
+
+    Transpose(r);
+
+    for (i = 0; i < 16; i++)
+      _mm512_mask_storeu_epi32(d[i], 0x00FF, r[i]);
+
+  }
+
+  // Byte swap the state words without transposing (lane-transposed digests)
+  void Store(__m512i *s, uint32_t *d) {
+
+    __m512i mask = _mm512_set1_epi32(0xFF00FF00);
+    for (int j = 0; j < 8; j++)
+      _mm512_storeu_si512(d + 16 * j, _mm512_ternarylogic_epi32(mask, _mm512_ror_epi32(s[j], 8), _mm512_rol_epi32(s[j], 8), 0xCA));
+
+  }
+
+  // 33 bytes message (compressed public key), 1 block: words 9..14 are zero and
+  // word 15 is the bit length, the schedule terms using them are folded.
+  void Transform33(__m512i *s, uint32_t *bi[16])
+  {
+    __m512i a, b, c, d, e, f, g, h;
+    __m512i w0, w1, w2, w3, w4, w5, w6, w7, w8;
+    __m512i T1, T2;
+    __m512i r[16];
+
+    a = _mm512_load_si512(s + 0);
+    b = _mm512_load_si512(s + 1);
+    c = _mm512_load_si512(s + 2);
+    d = _mm512_load_si512(s + 3);
+    e = _mm512_load_si512(s + 4);
+    f = _mm512_load_si512(s + 5);
+    g = _mm512_load_si512(s + 6);
+    h = _mm512_load_si512(s + 7);
+
+    for (int i = 0; i < 16; i++)
+      r[i] = _mm512_loadu_si512(bi[i]);
+    Transpose(r);
+
+    w0 = r[0];
+    w1 = r[1];
+    w2 = r[2];
+    w3 = r[3];
+    w4 = r[4];
+    w5 = r[5];
+    w6 = r[6];
+    w7 = r[7];
+    w8 = r[8];
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    Round(h, a, b, c, d, e, f, g, 0x71374491, w1);
+    Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w2);
+    Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x3956C25B, w4);
+    Round(d, e, f, g, h, a, b, c, 0x59F111F1, w5);
+    Round(c, d, e, f, g, h, a, b, 0x923F82A4, w6);
+    Round(b, c, d, e, f, g, h, a, 0xAB1C5ED5, w7);
+    Round(a, b, c, d, e, f, g, h, 0xD807AA98, w8);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF27C);
+    __m512i w16 = _mm512_add_epi32(s0(w1), w0);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w16);
+    __m512i w17 = add3(s0(w2), w1, _mm512_set1_epi32(0x00A50000));
+    Round(h, a, b, c, d, e, f, g, 0xEFBE4786, w17);
+    __m512i w18 = add3(s1(w16), s0(w3), w2);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    __m512i w19 = add3(s1(w17), s0(w4), w3);
+    Round(f, g, h, a, b, c, d, e, 0x240CA1CC, w19);
+    __m512i w20 = add3(s1(w18), s0(w5), w4);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    __m512i w21 = add3(s1(w19), s0(w6), w5);
+    Round(d, e, f, g, h, a, b, c, 0x4A7484AA, w21);
+    __m512i w22 = add4(s1(w20), s0(w7), w6, _mm512_set1_epi32(0x00000108));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m512i w23 = add4(s1(w21), w16, s0(w8), w7);
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m512i w24 = add3(s1(w22), w17, w8);
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m512i w25 = _mm512_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m512i w26 = _mm512_add_epi32(s1(w24), w19);
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m512i w27 = _mm512_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m512i w28 = _mm512_add_epi32(s1(w26), w21);
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m512i w29 = _mm512_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m512i w30 = add3(s1(w28), w23, _mm512_set1_epi32(0x10420023));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m512i w31 = add4(s1(w29), w24, s0(w16), _mm512_set1_epi32(0x00000108));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m512i w32 = add4(s1(w30), w25, s0(w17), w16);
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m512i w33 = add4(s1(w31), w26, s0(w18), w17);
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m512i w34 = add4(s1(w32), w27, s0(w19), w18);
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m512i w35 = add4(s1(w33), w28, s0(w20), w19);
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m512i w36 = add4(s1(w34), w29, s0(w21), w20);
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m512i w37 = add4(s1(w35), w30, s0(w22), w21);
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m512i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m512i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m512i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m512i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m512i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m512i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m512i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m512i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m512i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m512i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m512i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m512i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m512i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m512i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m512i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m512i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m512i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m512i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m512i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m512i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m512i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m512i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m512i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m512i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m512i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m512i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm512_add_epi32(a, s[0]);
+    s[1] = _mm512_add_epi32(b, s[1]);
+    s[2] = _mm512_add_epi32(c, s[2]);
+    s[3] = _mm512_add_epi32(d, s[3]);
+    s[4] = _mm512_add_epi32(e, s[4]);
+    s[5] = _mm512_add_epi32(f, s[5]);
+    s[6] = _mm512_add_epi32(g, s[6]);
+    s[7] = _mm512_add_epi32(h, s[7]);
+
+  }
+
+  // Second block of a 65 bytes message (uncompressed public key): only the first
+  // word (last byte of y + padding) is variable, the whole schedule is folded.
+  void Transform65(__m512i *s, uint32_t *bi[16])
+  {
+    __m512i a, b, c, d, e, f, g, h;
+    __m512i w0;
+    __m512i T1, T2;
+
+    a = _mm512_load_si512(s + 0);
+    b = _mm512_load_si512(s + 1);
+    c = _mm512_load_si512(s + 2);
+    d = _mm512_load_si512(s + 3);
+    e = _mm512_load_si512(s + 4);
+    f = _mm512_load_si512(s + 5);
+    g = _mm512_load_si512(s + 6);
+    h = _mm512_load_si512(s + 7);
+
+    w0 = _mm512_set_epi32(
+      bi[15][16], bi[14][16], bi[13][16], bi[12][16], bi[11][16], bi[10][16], bi[9][16], bi[8][16],
+      bi[7][16], bi[6][16], bi[5][16], bi[4][16], bi[3][16], bi[2][16], bi[1][16], bi[0][16]);
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    RoundC(h, a, b, c, d, e, f, g, 0x71374491);
+    RoundC(g, h, a, b, c, d, e, f, 0xB5C0FBCF);
+    RoundC(f, g, h, a, b, c, d, e, 0xE9B5DBA5);
+    RoundC(e, f, g, h, a, b, c, d, 0x3956C25B);
+    RoundC(d, e, f, g, h, a, b, c, 0x59F111F1);
+    RoundC(c, d, e, f, g, h, a, b, 0x923F82A4);
+    RoundC(b, c, d, e, f, g, h, a, 0xAB1C5ED5);
+    RoundC(a, b, c, d, e, f, g, h, 0xD807AA98);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF37C);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w0);
+    RoundC(h, a, b, c, d, e, f, g, 0xF1034786);
+    __m512i w18 = s1(w0);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    RoundC(f, g, h, a, b, c, d, e, 0x440CF396);
+    __m512i w20 = s1(w18);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    RoundC(d, e, f, g, h, a, b, c, 0x6D48D8BE);
+    __m512i w22 = _mm512_add_epi32(s1(w20), _mm512_set1_epi32(0x00000208));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m512i w23 = _mm512_add_epi32(w0, _mm512_set1_epi32(0xA0802025));
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m512i w24 = _mm512_add_epi32(s1(w22), _mm512_set1_epi32(0x01450000));
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m512i w25 = _mm512_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m512i w26 = _mm512_add_epi32(s1(w24), _mm512_set1_epi32(0x200051CA));
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m512i w27 = _mm512_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m512i w28 = _mm512_add_epi32(s1(w26), _mm512_set1_epi32(0x22D45414));
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m512i w29 = _mm512_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m512i w30 = add3(s1(w28), w23, _mm512_set1_epi32(0x10820045));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m512i w31 = add4(s1(w29), w24, s0(w0), _mm512_set1_epi32(0x00000208));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m512i w32 = add4(s1(w30), w25, w0, _mm512_set1_epi32(0x402A2A51));
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m512i w33 = add4(s1(w31), w26, s0(w18), _mm512_set1_epi32(0x01450000));
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m512i w34 = add4(s1(w32), w27, w18, _mm512_set1_epi32(0x8432829A));
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m512i w35 = add4(s1(w33), w28, s0(w20), _mm512_set1_epi32(0x200051CA));
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m512i w36 = add4(s1(w34), w29, w20, _mm512_set1_epi32(0x391A2A9F));
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m512i w37 = add4(s1(w35), w30, s0(w22), _mm512_set1_epi32(0x22D45414));
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m512i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m512i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m512i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m512i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m512i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m512i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m512i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m512i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m512i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m512i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m512i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m512i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m512i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m512i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m512i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m512i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m512i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m512i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m512i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m512i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m512i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m512i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m512i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m512i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m512i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m512i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm512_add_epi32(a, s[0]);
+    s[1] = _mm512_add_epi32(b, s[1]);
+    s[2] = _mm512_add_epi32(c, s[2]);
+    s[3] = _mm512_add_epi32(d, s[3]);
+    s[4] = _mm512_add_epi32(e, s[4]);
+    s[5] = _mm512_add_epi32(f, s[5]);
+    s[6] = _mm512_add_epi32(g, s[6]);
+    s[7] = _mm512_add_epi32(h, s[7]);
+
+  }
+
+  // P2SH redeem script (OP_0 PUSH20 hash160, 22 bytes), 1 block: the script words
+  // are built in registers from the lane-transposed P2PKH hash160 hi[5][n].
+  void Transform22(__m512i *s, uint32_t *hi)
+  {
+    __m512i a, b, c, d, e, f, g, h;
+    __m512i w0, w1, w2, w3, w4, w5;
+    __m512i T1, T2;
+    __m512i k[5];
+
+    a = _mm512_load_si512(s + 0);
+    b = _mm512_load_si512(s + 1);
+    c = _mm512_load_si512(s + 2);
+    d = _mm512_load_si512(s + 3);
+    e = _mm512_load_si512(s + 4);
+    f = _mm512_load_si512(s + 5);
+    g = _mm512_load_si512(s + 6);
+    h = _mm512_load_si512(s + 7);
+
+    // Byte swap the hash160 words (big endian message words)
+    __m512i mask = _mm512_set1_epi32(0xFF00FF00);
+    for (int j = 0; j < 5; j++) {
+      __m512i x = _mm512_loadu_si512(hi + 16 * j);
+      k[j] = _mm512_ternarylogic_epi32(mask, _mm512_ror_epi32(x, 8), _mm512_rol_epi32(x, 8), 0xCA);
+    }
+
+    // 0x00 0x14 h[0..19] 0x80
+    w0 = _mm512_or_si512(_mm512_set1_epi32(0x00140000), _mm512_srli_epi32(k[0], 16));
+    w1 = _mm512_or_si512(_mm512_slli_epi32(k[0], 16), _mm512_srli_epi32(k[1], 16));
+    w2 = _mm512_or_si512(_mm512_slli_epi32(k[1], 16), _mm512_srli_epi32(k[2], 16));
+    w3 = _mm512_or_si512(_mm512_slli_epi32(k[2], 16), _mm512_srli_epi32(k[3], 16));
+    w4 = _mm512_or_si512(_mm512_slli_epi32(k[3], 16), _mm512_srli_epi32(k[4], 16));
+    w5 = _mm512_or_si512(_mm512_slli_epi32(k[4], 16), _mm512_set1_epi32(0x8000));
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    Round(h, a, b, c, d, e, f, g, 0x71374491, w1);
+    Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w2);
+    Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x3956C25B, w4);
+    Round(d, e, f, g, h, a, b, c, 0x59F111F1, w5);
+    RoundC(c, d, e, f, g, h, a, b, 0x923F82A4);
+    RoundC(b, c, d, e, f, g, h, a, 0xAB1C5ED5);
+    RoundC(a, b, c, d, e, f, g, h, 0xD807AA98);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF224);
+    __m512i w16 = _mm512_add_epi32(s0(w1), w0);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w16);
+    __m512i w17 = add3(s0(w2), w1, _mm512_set1_epi32(0x004E0000));
+    Round(h, a, b, c, d, e, f, g, 0xEFBE4786, w17);
+    __m512i w18 = add3(s1(w16), s0(w3), w2);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    __m512i w19 = add3(s1(w17), s0(w4), w3);
+    Round(f, g, h, a, b, c, d, e, 0x240CA1CC, w19);
+    __m512i w20 = add3(s1(w18), s0(w5), w4);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    __m512i w21 = _mm512_add_epi32(s1(w19), w5);
+    Round(d, e, f, g, h, a, b, c, 0x4A7484AA, w21);
+    __m512i w22 = _mm512_add_epi32(s1(w20), _mm512_set1_epi32(0x000000B0));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m512i w23 = _mm512_add_epi32(s1(w21), w16);
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m512i w24 = _mm512_add_epi32(s1(w22), w17);
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m512i w25 = _mm512_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m512i w26 = _mm512_add_epi32(s1(w24), w19);
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m512i w27 = _mm512_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m512i w28 = _mm512_add_epi32(s1(w26), w21);
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m512i w29 = _mm512_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m512i w30 = add3(s1(w28), w23, _mm512_set1_epi32(0x602C0017));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m512i w31 = add4(s1(w29), w24, s0(w16), _mm512_set1_epi32(0x000000B0));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m512i w32 = add4(s1(w30), w25, s0(w17), w16);
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m512i w33 = add4(s1(w31), w26, s0(w18), w17);
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m512i w34 = add4(s1(w32), w27, s0(w19), w18);
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m512i w35 = add4(s1(w33), w28, s0(w20), w19);
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m512i w36 = add4(s1(w34), w29, s0(w21), w20);
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m512i w37 = add4(s1(w35), w30, s0(w22), w21);
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m512i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m512i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m512i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m512i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m512i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m512i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m512i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m512i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m512i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m512i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m512i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m512i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m512i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m512i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m512i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m512i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m512i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m512i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m512i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m512i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m512i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m512i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m512i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m512i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m512i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m512i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm512_add_epi32(a, s[0]);
+    s[1] = _mm512_add_epi32(b, s[1]);
+    s[2] = _mm512_add_epi32(c, s[2]);
+    s[3] = _mm512_add_epi32(d, s[3]);
+    s[4] = _mm512_add_epi32(e, s[4]);
+    s[5] = _mm512_add_epi32(f, s[5]);
+    s[6] = _mm512_add_epi32(g, s[6]);
+    s[7] = _mm512_add_epi32(h, s[7]);
+
+  }
+} // end namespace
+
+void sha256avx512_1B(uint32_t *i[16], unsigned char *d[16]) {
+
+  __m512i s[8];
+
+  _sha256avx512::Initialize(s);
+  _sha256avx512::Transform(s, i, 0);
+  _sha256avx512::Unpack(s, d);
+
+}
+
+void sha256avx512_2B(uint32_t *i[16], unsigned char *d[16]) {
+
+  __m512i s[8];
+
+  _sha256avx512::Initialize(s);
+  _sha256avx512::Transform(s, i, 0);
+  _sha256avx512::Transform(s, i, 1);
+  _sha256avx512::Unpack(s, d);
+
+}
+
+// Lane-transposed output: d[8][16] receives the digests as little endian
+// words (lane j = message j), ready to be used as RIPEMD160 message words.
+// The input buffers must hold the padded message (see Secp256K1::GetHash160T).
+void sha256avx512_33_t(uint32_t *i[16], uint32_t *d) {
+
+  __m512i s[8];
+
+  _sha256avx512::Initialize(s);
+  _sha256avx512::Transform33(s, i);
+  _sha256avx512::Store(s, d);
+
+}
+
+void sha256avx512_65_t(uint32_t *i[16], uint32_t *d) {
+
+  __m512i s[8];
+
+  _sha256avx512::Initialize(s);
+  _sha256avx512::Transform(s, i, 0);
+  _sha256avx512::Transform65(s, i);
+  _sha256avx512::Store(s, d);
+
+}
+
+// P2SH: h[5][16] holds the lane-transposed P2PKH hash160 (see ripemd160avx512_32_t)
+void sha256avx512_p2sh_t(uint32_t *h, uint32_t *d) {
+
+  __m512i s[8];
+
+  _sha256avx512::Initialize(s);
+  _sha256avx512::Transform22(s, h);
+  _sha256avx512::Store(s, d);
+
+}
@@ -0,0 +1,215 @@
+/*
+ * This file is part of the VanitySearch distribution (https://github.com/JeanLucPons/VanitySearch).
+ * Copyright (c) 2019 Jean Luc PONS.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sha256.h"
+#include <immintrin.h>
+#include <stdint.h>
+
+// SHA-256 using the Intel SHA extensions (sha256rnds2, sha256msg1, sha256msg2).
+// The state is kept in the ABEF/CDGH layout expected by sha256rnds2.
+
+namespace _sha256shani
+{
+
+#ifdef WIN64
+  static const __declspec(align(16)) uint32_t K[] = {
+#else
+  static const uint32_t K[] __attribute__ ((aligned (16))) = {
+#endif
+      0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+      0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+      0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+      0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+      0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+      0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+      0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+      0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+  };
+
+#ifdef WIN64
+  static const __declspec(align(16)) uint8_t BSWAP_MASK[] = {
+#else
+  static const uint8_t BSWAP_MASK[] __attribute__ ((aligned (16))) = {
+#endif
+      0x03,0x02,0x01,0x00,0x07,0x06,0x05,0x04,0x0b,0x0a,0x09,0x08,0x0f,0x0e,0x0d,0x0c
+  };
+
+#define LOADW(p) _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p)), _mm_load_si128((const __m128i *)BSWAP_MASK))
+
+  // 4 rounds, w = message words (already scheduled)
+#define QROUND(s0, s1, w, r) { \
+  __m128i m = _mm_add_epi32(w, _mm_load_si128((const __m128i *)(K + 4 * (r)))); \
+  s1 = _mm_sha256rnds2_epu32(s1, s0, m); \
+  s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(m, 0x0E)); }
+
+  // Message schedule
+#define MSG1(m0, m1) m0 = _mm_sha256msg1_epu32(m0, m1);
+#define MSG2(m0, m1, m2) m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1);
+#define MSG12(m0, m1, m2) MSG2(m0, m1, m2); MSG1(m0, m1);
+
+  // ABCD/EFGH -> ABEF/CDGH
+  static inline void Shuffle(__m128i &s0, __m128i &s1) {
+
+    __m128i t1 = _mm_shuffle_epi32(s0, 0xB1);
+    __m128i t2 = _mm_shuffle_epi32(s1, 0x1B);
+    s0 = _mm_alignr_epi8(t1, t2, 0x08);
+    s1 = _mm_blend_epi16(t2, t1, 0xF0);
+
+  }
+
+  // ABEF/CDGH -> ABCD/EFGH
+  static inline void Unshuffle(__m128i &s0, __m128i &s1) {
+
+    __m128i t1 = _mm_shuffle_epi32(s0, 0x1B);
+    __m128i t2 = _mm_shuffle_epi32(s1, 0xB1);
+    s0 = _mm_blend_epi16(t1, t2, 0xF0);
+    s1 = _mm_alignr_epi8(t2, t1, 0x08);
+
+  }
+
+  void Transform(uint32_t *s, const uint8_t *chunk, int nbBlock) {
+
+    __m128i s0 = _mm_loadu_si128((const __m128i *)s);
+    __m128i s1 = _mm_loadu_si128((const __m128i *)(s + 4));
+    Shuffle(s0, s1);
+
+    for (int b = 0; b < nbBlock; b++) {
+
+      __m128i so0 = s0;
+      __m128i so1 = s1;
+      __m128i m0, m1, m2, m3;
+
+      m0 = LOADW(chunk);
+      QROUND(s0, s1, m0, 0);
+      m1 = LOADW(chunk + 16);
+      QROUND(s0, s1, m1, 1); MSG1(m0, m1);
+      m2 = LOADW(chunk + 32);
+      QROUND(s0, s1, m2, 2); MSG1(m1, m2);
+      m3 = LOADW(chunk + 48);
+      QROUND(s0, s1, m3, 3); MSG12(m2, m3, m0);
+      QROUND(s0, s1, m0, 4); MSG12(m3, m0, m1);
+      QROUND(s0, s1, m1, 5); MSG12(m0, m1, m2);
+      QROUND(s0, s1, m2, 6); MSG12(m1, m2, m3);
+      QROUND(s0, s1, m3, 7); MSG12(m2, m3, m0);
+      QROUND(s0, s1, m0, 8); MSG12(m3, m0, m1);
+      QROUND(s0, s1, m1, 9); MSG12(m0, m1, m2);
+      QROUND(s0, s1, m2, 10); MSG12(m1, m2, m3);
+      QROUND(s0, s1, m3, 11); MSG12(m2, m3, m0);
+      QROUND(s0, s1, m0, 12); MSG12(m3, m0, m1);
+      QROUND(s0, s1, m1, 13); MSG2(m0, m1, m2);
+      QROUND(s0, s1, m2, 14); MSG2(m1, m2, m3);
+      QROUND(s0, s1, m3, 15);
+
+      s0 = _mm_add_epi32(s0, so0);
+      s1 = _mm_add_epi32(s1, so1);
+      chunk += 64;
+
+    }
+
+    Unshuffle(s0, s1);
+    _mm_storeu_si128((__m128i *)s, s0);
+    _mm_storeu_si128((__m128i *)(s + 4), s1);
+
+  }
+
+  // Two independent messages interleaved to hide the sha256rnds2 latency
+  void Transform2(uint32_t *sa, uint32_t *sb, const uint8_t *ca, const uint8_t *cb, int nbBlock) {
+
+    __m128i a0 = _mm_loadu_si128((const __m128i *)sa);
+    __m128i a1 = _mm_loadu_si128((const __m128i *)(sa + 4));
+    __m128i b0 = _mm_loadu_si128((const __m128i *)sb);
+    __m128i b1 = _mm_loadu_si128((const __m128i *)(sb + 4));
+    Shuffle(a0, a1);
+    Shuffle(b0, b1);
+
+    for (int b = 0; b < nbBlock; b++) {
+
+      __m128i ao0 = a0;
+      __m128i ao1 = a1;
+      __m128i bo0 = b0;
+      __m128i bo1 = b1;
+      __m128i am0, am1, am2, am3;
+      __m128i bm0, bm1, bm2, bm3;
+
+      am0 = LOADW(ca);
+      bm0 = LOADW(cb);
+      QROUND(a0, a1, am0, 0);
+      QROUND(b0, b1, bm0, 0);
+      am1 = LOADW(ca + 16);
+      bm1 = LOADW(cb + 16);
+      QROUND(a0, a1, am1, 1); MSG1(am0, am1);
+      QROUND(b0, b1, bm1, 1); MSG1(bm0, bm1);
+      am2 = LOADW(ca + 32);
+      bm2 = LOADW(cb + 32);
+      QROUND(a0, a1, am2, 2); MSG1(am1, am2);
+      QROUND(b0, b1, bm2, 2); MSG1(bm1, bm2);
+      am3 = LOADW(ca + 48);
+      bm3 = LOADW(cb + 48);
+      QROUND(a0, a1, am3, 3); MSG12(am2, am3, am0);
+      QROUND(b0, b1, bm3, 3); MSG12(bm2, bm3, bm0);
+      QROUND(a0, a1, am0, 4); MSG12(am3, am0, am1);
+      QROUND(b0, b1, bm0, 4); MSG12(bm3, bm0, bm1);
+      QROUND(a0, a1, am1, 5); MSG12(am0, am1, am2);
+      QROUND(b0, b1, bm1, 5); MSG12(bm0, bm1, bm2);
+      QROUND(a0, a1, am2, 6); MSG12(am1, am2, am3);
+      QROUND(b0, b1, bm2, 6); MSG12(bm1, bm2, bm3);
+      QROUND(a0, a1, am3, 7); MSG12(am2, am3, am0);
+      QROUND(b0, b1, bm3, 7); MSG12(bm2, bm3, bm0);
+      QROUND(a0, a1, am0, 8); MSG12(am3, am0, am1);
+      QROUND(b0, b1, bm0, 8); MSG12(bm3, bm0, bm1);
+      QROUND(a0, a1, am1, 9); MSG12(am0, am1, am2);
+      QROUND(b0, b1, bm1, 9); MSG12(bm0, bm1, bm2);
+      QROUND(a0, a1, am2, 10); MSG12(am1, am2, am3);
+      QROUND(b0, b1, bm2, 10); MSG12(bm1, bm2, bm3);
+      QROUND(a0, a1, am3, 11); MSG12(am2, am3, am0);
+      QROUND(b0, b1, bm3, 11); MSG12(bm2, bm3, bm0);
+      QROUND(a0, a1, am0, 12); MSG12(am3, am0, am1);
+      QROUND(b0, b1, bm0, 12); MSG12(bm3, bm0, bm1);
+      QROUND(a0, a1, am1, 13); MSG2(am0, am1, am2);
+      QROUND(b0, b1, bm1, 13); MSG2(bm0, bm1, bm2);
+      QROUND(a0, a1, am2, 14); MSG2(am1, am2, am3);
+      QROUND(b0, b1, bm2, 14); MSG2(bm1, bm2, bm3);
+      QROUND(a0, a1, am3, 15);
+      QROUND(b0, b1, bm3, 15);
+
+      a0 = _mm_add_epi32(a0, ao0);
+      a1 = _mm_add_epi32(a1, ao1);
+      b0 = _mm_add_epi32(b0, bo0);
+      b1 = _mm_add_epi32(b1, bo1);
+      ca += 64;
+      cb += 64;
+
+    }
+
+    Unshuffle(a0, a1);
+    Unshuffle(b0, b1);
+    _mm_storeu_si128((__m128i *)sa, a0);
+    _mm_storeu_si128((__m128i *)(sa + 4), a1);
+    _mm_storeu_si128((__m128i *)sb, b0);
+    _mm_storeu_si128((__m128i *)(sb + 4), b1);
+
+  }
+
+} // end namespace
+
+void sha256shani_transform(uint32_t *s, const uint8_t *chunk, int nbBlock) {
+  _sha256shani::Transform(s, chunk, nbBlock);
+}
+
+void sha256shani_transform_2w(uint32_t *s0, uint32_t *s1, const uint8_t *c0, const uint8_t *c1, int nbBlock) {
+  _sha256shani::Transform2(s0, s1, c0, c1, nbBlock);
+}
@@ -68,6 +68,13 @@ namespace _sha256sse
     T2 = _mm_add_epi32(S0(a), Maj(a, b, c));                \
     h = _mm_add_epi32(T1, T2);
 
+// Round with a constant message word, k = K[i] + w[i]
+#define	RoundC(a, b, c, d, e, f, g, h, k)                    \
+    T1 = add4(h, S1(e), Ch(e, f, g), _mm_set1_epi32(k));      \
+    d = _mm_add_epi32(d, T1);                               \
+    T2 = _mm_add_epi32(S0(a), Maj(a, b, c));                \
+    h = _mm_add_epi32(T1, T2);
+
 #define WMIX() \
   w0 = add4(s1(w14), w9, s0(w1), w0); \
   w1 = add4(s1(w15), w10, s0(w2), w1); \
@@ -421,6 +428,448 @@ namespace _sha256sse
 
   }
 
+  // 33 bytes message (compressed public key), 1 block: words 9..14 are zero and
+  // word 15 is the bit length, the schedule terms using them are folded.
+  void Transform33(__m128i *s, uint32_t *b0, uint32_t *b1, uint32_t *b2, uint32_t *b3) {
+    __m128i a, b, c, d, e, f, g, h;
+    __m128i w0, w1, w2, w3, w4, w5, w6, w7, w8;
+    __m128i T1, T2;
+
+    a = _mm_load_si128(s + 0);
+    b = _mm_load_si128(s + 1);
+    c = _mm_load_si128(s + 2);
+    d = _mm_load_si128(s + 3);
+    e = _mm_load_si128(s + 4);
+    f = _mm_load_si128(s + 5);
+    g = _mm_load_si128(s + 6);
+    h = _mm_load_si128(s + 7);
+
+    w0 = _mm_set_epi32(b0[0], b1[0], b2[0], b3[0]);
+    w1 = _mm_set_epi32(b0[1], b1[1], b2[1], b3[1]);
+    w2 = _mm_set_epi32(b0[2], b1[2], b2[2], b3[2]);
+    w3 = _mm_set_epi32(b0[3], b1[3], b2[3], b3[3]);
+    w4 = _mm_set_epi32(b0[4], b1[4], b2[4], b3[4]);
+    w5 = _mm_set_epi32(b0[5], b1[5], b2[5], b3[5]);
+    w6 = _mm_set_epi32(b0[6], b1[6], b2[6], b3[6]);
+    w7 = _mm_set_epi32(b0[7], b1[7], b2[7], b3[7]);
+    w8 = _mm_set_epi32(b0[8], b1[8], b2[8], b3[8]);
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    Round(h, a, b, c, d, e, f, g, 0x71374491, w1);
+    Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w2);
+    Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x3956C25B, w4);
+    Round(d, e, f, g, h, a, b, c, 0x59F111F1, w5);
+    Round(c, d, e, f, g, h, a, b, 0x923F82A4, w6);
+    Round(b, c, d, e, f, g, h, a, 0xAB1C5ED5, w7);
+    Round(a, b, c, d, e, f, g, h, 0xD807AA98, w8);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF27C);
+    __m128i w16 = _mm_add_epi32(s0(w1), w0);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w16);
+    __m128i w17 = add3(s0(w2), w1, _mm_set1_epi32(0x00A50000));
+    Round(h, a, b, c, d, e, f, g, 0xEFBE4786, w17);
+    __m128i w18 = add3(s1(w16), s0(w3), w2);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    __m128i w19 = add3(s1(w17), s0(w4), w3);
+    Round(f, g, h, a, b, c, d, e, 0x240CA1CC, w19);
+    __m128i w20 = add3(s1(w18), s0(w5), w4);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    __m128i w21 = add3(s1(w19), s0(w6), w5);
+    Round(d, e, f, g, h, a, b, c, 0x4A7484AA, w21);
+    __m128i w22 = add4(s1(w20), s0(w7), w6, _mm_set1_epi32(0x00000108));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m128i w23 = add4(s1(w21), w16, s0(w8), w7);
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m128i w24 = add3(s1(w22), w17, w8);
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m128i w25 = _mm_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m128i w26 = _mm_add_epi32(s1(w24), w19);
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m128i w27 = _mm_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m128i w28 = _mm_add_epi32(s1(w26), w21);
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m128i w29 = _mm_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m128i w30 = add3(s1(w28), w23, _mm_set1_epi32(0x10420023));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m128i w31 = add4(s1(w29), w24, s0(w16), _mm_set1_epi32(0x00000108));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m128i w32 = add4(s1(w30), w25, s0(w17), w16);
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m128i w33 = add4(s1(w31), w26, s0(w18), w17);
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m128i w34 = add4(s1(w32), w27, s0(w19), w18);
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m128i w35 = add4(s1(w33), w28, s0(w20), w19);
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m128i w36 = add4(s1(w34), w29, s0(w21), w20);
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m128i w37 = add4(s1(w35), w30, s0(w22), w21);
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m128i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m128i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m128i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m128i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m128i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m128i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m128i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m128i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m128i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m128i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m128i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m128i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m128i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m128i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m128i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m128i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m128i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m128i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m128i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m128i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m128i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m128i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m128i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m128i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m128i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m128i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm_add_epi32(a, s[0]);
+    s[1] = _mm_add_epi32(b, s[1]);
+    s[2] = _mm_add_epi32(c, s[2]);
+    s[3] = _mm_add_epi32(d, s[3]);
+    s[4] = _mm_add_epi32(e, s[4]);
+    s[5] = _mm_add_epi32(f, s[5]);
+    s[6] = _mm_add_epi32(g, s[6]);
+    s[7] = _mm_add_epi32(h, s[7]);
+
+  }
+
+  // Second block of a 65 bytes message (uncompressed public key): only the first
+  // word (last byte of y + padding) is variable, the whole schedule is folded.
+  void Transform65(__m128i *s, uint32_t *b0, uint32_t *b1, uint32_t *b2, uint32_t *b3) {
+    __m128i a, b, c, d, e, f, g, h;
+    __m128i w0;
+    __m128i T1, T2;
+
+    a = _mm_load_si128(s + 0);
+    b = _mm_load_si128(s + 1);
+    c = _mm_load_si128(s + 2);
+    d = _mm_load_si128(s + 3);
+    e = _mm_load_si128(s + 4);
+    f = _mm_load_si128(s + 5);
+    g = _mm_load_si128(s + 6);
+    h = _mm_load_si128(s + 7);
+
+    w0 = _mm_set_epi32(b0[16], b1[16], b2[16], b3[16]);
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    RoundC(h, a, b, c, d, e, f, g, 0x71374491);
+    RoundC(g, h, a, b, c, d, e, f, 0xB5C0FBCF);
+    RoundC(f, g, h, a, b, c, d, e, 0xE9B5DBA5);
+    RoundC(e, f, g, h, a, b, c, d, 0x3956C25B);
+    RoundC(d, e, f, g, h, a, b, c, 0x59F111F1);
+    RoundC(c, d, e, f, g, h, a, b, 0x923F82A4);
+    RoundC(b, c, d, e, f, g, h, a, 0xAB1C5ED5);
+    RoundC(a, b, c, d, e, f, g, h, 0xD807AA98);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF37C);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w0);
+    RoundC(h, a, b, c, d, e, f, g, 0xF1034786);
+    __m128i w18 = s1(w0);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    RoundC(f, g, h, a, b, c, d, e, 0x440CF396);
+    __m128i w20 = s1(w18);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    RoundC(d, e, f, g, h, a, b, c, 0x6D48D8BE);
+    __m128i w22 = _mm_add_epi32(s1(w20), _mm_set1_epi32(0x00000208));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m128i w23 = _mm_add_epi32(w0, _mm_set1_epi32(0xA0802025));
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m128i w24 = _mm_add_epi32(s1(w22), _mm_set1_epi32(0x01450000));
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m128i w25 = _mm_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m128i w26 = _mm_add_epi32(s1(w24), _mm_set1_epi32(0x200051CA));
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m128i w27 = _mm_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m128i w28 = _mm_add_epi32(s1(w26), _mm_set1_epi32(0x22D45414));
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m128i w29 = _mm_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m128i w30 = add3(s1(w28), w23, _mm_set1_epi32(0x10820045));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m128i w31 = add4(s1(w29), w24, s0(w0), _mm_set1_epi32(0x00000208));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m128i w32 = add4(s1(w30), w25, w0, _mm_set1_epi32(0x402A2A51));
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m128i w33 = add4(s1(w31), w26, s0(w18), _mm_set1_epi32(0x01450000));
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m128i w34 = add4(s1(w32), w27, w18, _mm_set1_epi32(0x8432829A));
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m128i w35 = add4(s1(w33), w28, s0(w20), _mm_set1_epi32(0x200051CA));
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m128i w36 = add4(s1(w34), w29, w20, _mm_set1_epi32(0x391A2A9F));
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m128i w37 = add4(s1(w35), w30, s0(w22), _mm_set1_epi32(0x22D45414));
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m128i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m128i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m128i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m128i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m128i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m128i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m128i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m128i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m128i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m128i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m128i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m128i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m128i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m128i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m128i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m128i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m128i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m128i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m128i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m128i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m128i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m128i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m128i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m128i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m128i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m128i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm_add_epi32(a, s[0]);
+    s[1] = _mm_add_epi32(b, s[1]);
+    s[2] = _mm_add_epi32(c, s[2]);
+    s[3] = _mm_add_epi32(d, s[3]);
+    s[4] = _mm_add_epi32(e, s[4]);
+    s[5] = _mm_add_epi32(f, s[5]);
+    s[6] = _mm_add_epi32(g, s[6]);
+    s[7] = _mm_add_epi32(h, s[7]);
+
+  }
+
+  // P2SH redeem script (OP_0 PUSH20 hash160, 22 bytes), 1 block: the script words
+  // are built in registers from the lane-transposed P2PKH hash160 hi[5][n].
+  void Transform22(__m128i *s, uint32_t *hi) {
+    __m128i a, b, c, d, e, f, g, h;
+    __m128i w0, w1, w2, w3, w4, w5;
+    __m128i T1, T2;
+    __m128i k[5];
+
+    a = _mm_load_si128(s + 0);
+    b = _mm_load_si128(s + 1);
+    c = _mm_load_si128(s + 2);
+    d = _mm_load_si128(s + 3);
+    e = _mm_load_si128(s + 4);
+    f = _mm_load_si128(s + 5);
+    g = _mm_load_si128(s + 6);
+    h = _mm_load_si128(s + 7);
+
+    // Byte swap the hash160 words (big endian message words)
+    // Lane 3 holds message 0: reverse the 16 bytes to byte swap and reorder
+    __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (int j = 0; j < 5; j++)
+      k[j] = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)(hi + 4 * j)), mask);
+
+    // 0x00 0x14 h[0..19] 0x80
+    w0 = _mm_or_si128(_mm_set1_epi32(0x00140000), _mm_srli_epi32(k[0], 16));
+    w1 = _mm_or_si128(_mm_slli_epi32(k[0], 16), _mm_srli_epi32(k[1], 16));
+    w2 = _mm_or_si128(_mm_slli_epi32(k[1], 16), _mm_srli_epi32(k[2], 16));
+    w3 = _mm_or_si128(_mm_slli_epi32(k[2], 16), _mm_srli_epi32(k[3], 16));
+    w4 = _mm_or_si128(_mm_slli_epi32(k[3], 16), _mm_srli_epi32(k[4], 16));
+    w5 = _mm_or_si128(_mm_slli_epi32(k[4], 16), _mm_set1_epi32(0x8000));
+
+    Round(a, b, c, d, e, f, g, h, 0x428A2F98, w0);
+    Round(h, a, b, c, d, e, f, g, 0x71374491, w1);
+    Round(g, h, a, b, c, d, e, f, 0xB5C0FBCF, w2);
+    Round(f, g, h, a, b, c, d, e, 0xE9B5DBA5, w3);
+    Round(e, f, g, h, a, b, c, d, 0x3956C25B, w4);
+    Round(d, e, f, g, h, a, b, c, 0x59F111F1, w5);
+    RoundC(c, d, e, f, g, h, a, b, 0x923F82A4);
+    RoundC(b, c, d, e, f, g, h, a, 0xAB1C5ED5);
+    RoundC(a, b, c, d, e, f, g, h, 0xD807AA98);
+    RoundC(h, a, b, c, d, e, f, g, 0x12835B01);
+    RoundC(g, h, a, b, c, d, e, f, 0x243185BE);
+    RoundC(f, g, h, a, b, c, d, e, 0x550C7DC3);
+    RoundC(e, f, g, h, a, b, c, d, 0x72BE5D74);
+    RoundC(d, e, f, g, h, a, b, c, 0x80DEB1FE);
+    RoundC(c, d, e, f, g, h, a, b, 0x9BDC06A7);
+    RoundC(b, c, d, e, f, g, h, a, 0xC19BF224);
+    __m128i w16 = _mm_add_epi32(s0(w1), w0);
+    Round(a, b, c, d, e, f, g, h, 0xE49B69C1, w16);
+    __m128i w17 = add3(s0(w2), w1, _mm_set1_epi32(0x004E0000));
+    Round(h, a, b, c, d, e, f, g, 0xEFBE4786, w17);
+    __m128i w18 = add3(s1(w16), s0(w3), w2);
+    Round(g, h, a, b, c, d, e, f, 0x0FC19DC6, w18);
+    __m128i w19 = add3(s1(w17), s0(w4), w3);
+    Round(f, g, h, a, b, c, d, e, 0x240CA1CC, w19);
+    __m128i w20 = add3(s1(w18), s0(w5), w4);
+    Round(e, f, g, h, a, b, c, d, 0x2DE92C6F, w20);
+    __m128i w21 = _mm_add_epi32(s1(w19), w5);
+    Round(d, e, f, g, h, a, b, c, 0x4A7484AA, w21);
+    __m128i w22 = _mm_add_epi32(s1(w20), _mm_set1_epi32(0x000000B0));
+    Round(c, d, e, f, g, h, a, b, 0x5CB0A9DC, w22);
+    __m128i w23 = _mm_add_epi32(s1(w21), w16);
+    Round(b, c, d, e, f, g, h, a, 0x76F988DA, w23);
+    __m128i w24 = _mm_add_epi32(s1(w22), w17);
+    Round(a, b, c, d, e, f, g, h, 0x983E5152, w24);
+    __m128i w25 = _mm_add_epi32(s1(w23), w18);
+    Round(h, a, b, c, d, e, f, g, 0xA831C66D, w25);
+    __m128i w26 = _mm_add_epi32(s1(w24), w19);
+    Round(g, h, a, b, c, d, e, f, 0xB00327C8, w26);
+    __m128i w27 = _mm_add_epi32(s1(w25), w20);
+    Round(f, g, h, a, b, c, d, e, 0xBF597FC7, w27);
+    __m128i w28 = _mm_add_epi32(s1(w26), w21);
+    Round(e, f, g, h, a, b, c, d, 0xC6E00BF3, w28);
+    __m128i w29 = _mm_add_epi32(s1(w27), w22);
+    Round(d, e, f, g, h, a, b, c, 0xD5A79147, w29);
+    __m128i w30 = add3(s1(w28), w23, _mm_set1_epi32(0x602C0017));
+    Round(c, d, e, f, g, h, a, b, 0x06CA6351, w30);
+    __m128i w31 = add4(s1(w29), w24, s0(w16), _mm_set1_epi32(0x000000B0));
+    Round(b, c, d, e, f, g, h, a, 0x14292967, w31);
+    __m128i w32 = add4(s1(w30), w25, s0(w17), w16);
+    Round(a, b, c, d, e, f, g, h, 0x27B70A85, w32);
+    __m128i w33 = add4(s1(w31), w26, s0(w18), w17);
+    Round(h, a, b, c, d, e, f, g, 0x2E1B2138, w33);
+    __m128i w34 = add4(s1(w32), w27, s0(w19), w18);
+    Round(g, h, a, b, c, d, e, f, 0x4D2C6DFC, w34);
+    __m128i w35 = add4(s1(w33), w28, s0(w20), w19);
+    Round(f, g, h, a, b, c, d, e, 0x53380D13, w35);
+    __m128i w36 = add4(s1(w34), w29, s0(w21), w20);
+    Round(e, f, g, h, a, b, c, d, 0x650A7354, w36);
+    __m128i w37 = add4(s1(w35), w30, s0(w22), w21);
+    Round(d, e, f, g, h, a, b, c, 0x766A0ABB, w37);
+    __m128i w38 = add4(s1(w36), w31, s0(w23), w22);
+    Round(c, d, e, f, g, h, a, b, 0x81C2C92E, w38);
+    __m128i w39 = add4(s1(w37), w32, s0(w24), w23);
+    Round(b, c, d, e, f, g, h, a, 0x92722C85, w39);
+    __m128i w40 = add4(s1(w38), w33, s0(w25), w24);
+    Round(a, b, c, d, e, f, g, h, 0xA2BFE8A1, w40);
+    __m128i w41 = add4(s1(w39), w34, s0(w26), w25);
+    Round(h, a, b, c, d, e, f, g, 0xA81A664B, w41);
+    __m128i w42 = add4(s1(w40), w35, s0(w27), w26);
+    Round(g, h, a, b, c, d, e, f, 0xC24B8B70, w42);
+    __m128i w43 = add4(s1(w41), w36, s0(w28), w27);
+    Round(f, g, h, a, b, c, d, e, 0xC76C51A3, w43);
+    __m128i w44 = add4(s1(w42), w37, s0(w29), w28);
+    Round(e, f, g, h, a, b, c, d, 0xD192E819, w44);
+    __m128i w45 = add4(s1(w43), w38, s0(w30), w29);
+    Round(d, e, f, g, h, a, b, c, 0xD6990624, w45);
+    __m128i w46 = add4(s1(w44), w39, s0(w31), w30);
+    Round(c, d, e, f, g, h, a, b, 0xF40E3585, w46);
+    __m128i w47 = add4(s1(w45), w40, s0(w32), w31);
+    Round(b, c, d, e, f, g, h, a, 0x106AA070, w47);
+    __m128i w48 = add4(s1(w46), w41, s0(w33), w32);
+    Round(a, b, c, d, e, f, g, h, 0x19A4C116, w48);
+    __m128i w49 = add4(s1(w47), w42, s0(w34), w33);
+    Round(h, a, b, c, d, e, f, g, 0x1E376C08, w49);
+    __m128i w50 = add4(s1(w48), w43, s0(w35), w34);
+    Round(g, h, a, b, c, d, e, f, 0x2748774C, w50);
+    __m128i w51 = add4(s1(w49), w44, s0(w36), w35);
+    Round(f, g, h, a, b, c, d, e, 0x34B0BCB5, w51);
+    __m128i w52 = add4(s1(w50), w45, s0(w37), w36);
+    Round(e, f, g, h, a, b, c, d, 0x391C0CB3, w52);
+    __m128i w53 = add4(s1(w51), w46, s0(w38), w37);
+    Round(d, e, f, g, h, a, b, c, 0x4ED8AA4A, w53);
+    __m128i w54 = add4(s1(w52), w47, s0(w39), w38);
+    Round(c, d, e, f, g, h, a, b, 0x5B9CCA4F, w54);
+    __m128i w55 = add4(s1(w53), w48, s0(w40), w39);
+    Round(b, c, d, e, f, g, h, a, 0x682E6FF3, w55);
+    __m128i w56 = add4(s1(w54), w49, s0(w41), w40);
+    Round(a, b, c, d, e, f, g, h, 0x748F82EE, w56);
+    __m128i w57 = add4(s1(w55), w50, s0(w42), w41);
+    Round(h, a, b, c, d, e, f, g, 0x78A5636F, w57);
+    __m128i w58 = add4(s1(w56), w51, s0(w43), w42);
+    Round(g, h, a, b, c, d, e, f, 0x84C87814, w58);
+    __m128i w59 = add4(s1(w57), w52, s0(w44), w43);
+    Round(f, g, h, a, b, c, d, e, 0x8CC70208, w59);
+    __m128i w60 = add4(s1(w58), w53, s0(w45), w44);
+    Round(e, f, g, h, a, b, c, d, 0x90BEFFFA, w60);
+    __m128i w61 = add4(s1(w59), w54, s0(w46), w45);
+    Round(d, e, f, g, h, a, b, c, 0xA4506CEB, w61);
+    __m128i w62 = add4(s1(w60), w55, s0(w47), w46);
+    Round(c, d, e, f, g, h, a, b, 0xBEF9A3F7, w62);
+    __m128i w63 = add4(s1(w61), w56, s0(w48), w47);
+    Round(b, c, d, e, f, g, h, a, 0xC67178F2, w63);
+
+    s[0] = _mm_add_epi32(a, s[0]);
+    s[1] = _mm_add_epi32(b, s[1]);
+    s[2] = _mm_add_epi32(c, s[2]);
+    s[3] = _mm_add_epi32(d, s[3]);
+    s[4] = _mm_add_epi32(e, s[4]);
+    s[5] = _mm_add_epi32(f, s[5]);
+    s[6] = _mm_add_epi32(g, s[6]);
+    s[7] = _mm_add_epi32(h, s[7]);
+
+  }
 } // end namespace
 
 void sha256sse_1B(
@@ -553,6 +1002,50 @@ void sha256sse_2B(
 
 }
 
+// Lane-transposed output: d[8][4] receives the digests as little endian
+// words (lane j = message j), ready to be used as RIPEMD160 message words.
+// The input buffers must hold the padded message (see Secp256K1::GetHash160T).
+static inline void StoreT(__m128i *s, uint32_t *d) {
+
+  // Lane 3 holds message 0: reverse the 16 bytes to byte swap and reorder
+  __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  for (int j = 0; j < 8; j++)
+    _mm_storeu_si128((__m128i *)(d + 4 * j), _mm_shuffle_epi8(s[j], mask));
+
+}
+
+void sha256sse_33_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3, uint32_t *d) {
+
+  __m128i s[8];
+
+  _sha256sse::Initialize(s);
+  _sha256sse::Transform33(s, i0, i1, i2, i3);
+  StoreT(s, d);
+
+}
+
+void sha256sse_65_t(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3, uint32_t *d) {
+
+  __m128i s[8];
+
+  _sha256sse::Initialize(s);
+  _sha256sse::Transform(s, i0, i1, i2, i3);
+  _sha256sse::Transform65(s, i0, i1, i2, i3);
+  StoreT(s, d);
+
+}
+
+// P2SH: h[5][4] holds the lane-transposed P2PKH hash160 (see ripemd160sse_32_t)
+void sha256sse_p2sh_t(uint32_t *h, uint32_t *d) {
+
+  __m128i s[8];
+
+  _sha256sse::Initialize(s);
+  _sha256sse::Transform22(s, h);
+  StoreT(s, d);
+
+}
+
 void sha256sse_checksum(uint32_t *i0, uint32_t *i1, uint32_t *i2, uint32_t *i3,
   uint8_t *d0, uint8_t *d1, uint8_t *d2, uint8_t *d3) {
 
@@ -36,7 +36,7 @@ void printUsage() {
 	printf("VanitySeacrh [-check] [-v] [-u] [-b] [-c] [-gpu] [-stop] [-i inputfile]\n");
 	printf("             [-gpuId gpuId1[,gpuId2,...]] [-g g1x,g1y,[,g2x,g2y,...]]\n");
 	printf("             [-o outputfile] [-m maxFound] [-ps seed] [-s seed] [-t nbThread]\n");
-	printf("             [-nosse] [-r rekey] [-check] [-kp] [-sp startPubKey]\n");
+	printf("             [-nosse] [-hash-backend name] [-field-backend name] [-streams n] [-autotune] [-noadx] [-gtable-window bits] [-r rekey] [-check] [-kp] [-sp startPubKey]\n");
 	printf("             [-rp privkey partialkeyfile] [prefix]\n\n");
 	printf(" prefix: prefix to search (Can contains wildcard '?' or '*')\n");
 	printf(" -v: Print version\n");
@@ -54,7 +54,13 @@ void printUsage() {
 	printf(" -s seed: Specify a seed for the base key, default is random\n");
 	printf(" -ps seed: Specify a seed concatened with a crypto secure random seed\n");
 	printf(" -t threadNumber: Specify number of CPU thread, default is number of core\n");
-	printf(" -nosse: Disable SSE hash function\n");
+	printf(" -nosse: Disable SSE hash function (same as -hash-backend scalar)\n");
+	printf(" -hash-backend name: CPU hash backend (auto, scalar, sse, avx2 or avx512), default is auto (widest supported by the CPU)\n");
+	printf(" -field-backend name: CPU group walk field arithmetic (auto, scalar, avx2 or ifma), default is auto (ifma if supported by the CPU, scalar otherwise)\n");
+	printf(" -streams n: Number of independent key streams walked in lockstep by each CPU thread (1 to %d), default is 1\n", CPU_STREAM_MAX);
+	printf(" -autotune: Time short CPU search trials (group size, streams, threads, hash and field backends) and save the best profile for this host, later runs load it\n");
+	printf(" -noadx: Disable the MULX/ADX field multiplication (used when supported by the CPU)\n");
+	printf(" -gtable-window bits: Window size of the generator table (4 to 16), default is 8, must precede -cp/-kp/-check\n");
 	printf(" -l: List cuda enabled devices\n");
 	printf(" -check: Check CPU and GPU kernel vs CPU\n");
 	printf(" -cp privKey: Compute public key (privKey in hex hormat)\n");
@@ -121,6 +127,50 @@ void getInts(string name, vector<int>& tokens, const string& text, char sep) {
 
 // ------------------------------------------------------------------------------------------
 
+int getHashBackend(char* v) {
+
+	if (strcmp(v, "auto") == 0)
+		return Secp256K1::GetHashBackend();
+
+	for (int b = 0; b < HASH_NB_BACKEND; b++) {
+		if (strcmp(v, Secp256K1::GetHashBackendName(b)) == 0) {
+			if (!Secp256K1::IsHashBackendSupported(b)) {
+				printf("Hash backend %s not supported by this CPU\n", v);
+				exit(-1);
+			}
+			return b;
+		}
+	}
+
+	printf("Invalid hash-backend argument, auto, scalar, sse, avx2 or avx512 expected\n");
+	exit(-1);
+
+}
+
+// ------------------------------------------------------------------------------------------
+
+int getFieldBackend(char* v) {
+
+	if (strcmp(v, "auto") == 0)
+		return Secp256K1::GetFieldBackend();
+
+	for (int b = 0; b < FIELD_NB_BACKEND; b++) {
+		if (strcmp(v, Secp256K1::GetFieldBackendName(b)) == 0) {
+			if (!Secp256K1::IsFieldBackendSupported(b)) {
+				printf("Field backend %s not supported by this CPU\n", v);
+				exit(-1);
+			}
+			return b;
+		}
+	}
+
+	printf("Invalid field-backend argument, auto, scalar, avx2 or ifma expected\n");
+	exit(-1);
+
+}
+
+// ------------------------------------------------------------------------------------------
+
 void parseFile(string fileName, vector<string>& lines) {
 
 	// Get file size
@@ -382,6 +432,9 @@ int main(int argc, char* argv[]) {
 	// Init Int
 	Int::Init();
 
+	// Init SHA256 (SHA extensions)
+	sha256_init();
+
 	// Init SecpK1
 	Secp256K1::Init();
 
@@ -402,7 +455,8 @@ int main(int argc, char* argv[]) {
 	string outputFile = "";
 	int nbCPUThread = Timer::getCoreNumber();
 	bool tSpecified = false;
-	bool sse = true;
+	int hashBackend = Secp256K1::GetHashBackend();
+	int fieldBackend = Secp256K1::GetFieldBackend();
 	uint32_t maxFound = 65536;
 	uint64_t rekey = 0;
 	Int startKey;
@@ -412,6 +466,11 @@ int main(int argc, char* argv[]) {
 	bool startPubKeyCompressed;
 	bool caseSensitive = true;
 	bool paranoiacSeed = false;
+	bool autotune = false;
+	bool hashSpecified = false;
+	bool fieldSpecified = false;
+	int nbStream = 1;
+	bool streamsSpecified = false;
 
 	while (a < argc) {
 
@@ -530,7 +589,48 @@ int main(int argc, char* argv[]) {
 			a++;
 		}
 		else if (strcmp(argv[a], "-nosse") == 0) {
-			sse = false;
+			hashBackend = HASH_SCALAR;
+			hashSpecified = true;
+			a++;
+		}
+		else if (strcmp(argv[a], "-hash-backend") == 0) {
+			a++;
+			hashBackend = getHashBackend(argv[a]);
+			hashSpecified = true;
+			a++;
+		}
+		else if (strcmp(argv[a], "-autotune") == 0) {
+			autotune = true;
+			a++;
+		}
+		else if (strcmp(argv[a], "-noadx") == 0) {
+			Int::mulxAdx = false;
+			a++;
+		}
+		else if (strcmp(argv[a], "-gtable-window") == 0) {
+			a++;
+			int w = getInt("gtable-window", argv[a]);
+			if (w < GTABLE_WINDOW_MIN || w > GTABLE_WINDOW_MAX) {
+				printf("Invalid gtable-window argument, %d to %d expected\n", GTABLE_WINDOW_MIN, GTABLE_WINDOW_MAX);
+				exit(-1);
+			}
+			Secp256K1::InitGTable(w);
+			a++;
+		}
+		else if (strcmp(argv[a], "-field-backend") == 0) {
+			a++;
+			fieldBackend = getFieldBackend(argv[a]);
+			fieldSpecified = true;
+			a++;
+		}
+		else if (strcmp(argv[a], "-streams") == 0) {
+			a++;
+			nbStream = getInt("streams", argv[a]);
+			if (nbStream < 1 || nbStream > CPU_STREAM_MAX) {
+				printf("Invalid streams argument, 1 to %d expected\n", CPU_STREAM_MAX);
+				exit(-1);
+			}
+			streamsSpecified = true;
 			a++;
 		}
 		else if (strcmp(argv[a], "-g") == 0) {
@@ -602,6 +702,37 @@ int main(int argc, char* argv[]) {
 		exit(-1);
 	}
 
+	// CPU profile of this host (written by -autotune), explicit options take precedence
+	TUNE_PROFILE profile;
+	string profileFile = VanitySearch::GetProfileFile();
+	bool hasProfile = !autotune && VanitySearch::LoadProfile(profileFile, profile);
+	if (hasProfile) {
+		printf("CPU profile: %s\n", profileFile.c_str());
+		if (!tSpecified) nbCPUThread = profile.nbThread;
+		if (!hashSpecified) hashBackend = profile.hashBackend;
+		if (!fieldSpecified) fieldBackend = profile.fieldBackend;
+		if (!streamsSpecified) nbStream = profile.nbStream;
+	}
+
+	// If a starting public key is specified, force the search mode according to the key
+	if (!startPuKey.isZero()) {
+		searchMode = (startPubKeyCompressed) ? SEARCH_COMPRESSED : SEARCH_UNCOMPRESSED;
+	}
+
+	VanitySearch* v = new VanitySearch(prefix, seed, searchMode, gpuEnable, stop, outputFile, hashBackend,
+		fieldBackend, maxFound, rekey, caseSensitive, startPuKey, paranoiacSeed, startKey);
+
+	if (hasProfile) {
+		v->InitCPUGroup(profile.grpSize);
+	}
+	v->SetCPUStreams(nbStream);
+	if (autotune && nbCPUThread > 0) {
+		v->Autotune(nbCPUThread, profile);
+		if (VanitySearch::SaveProfile(profileFile, profile))
+			printf("CPU profile saved to %s\n", profileFile.c_str());
+		nbCPUThread = profile.nbThread;
+	}
+
 	// Let one CPU core free per gpu is gpu is enabled
 	// It will avoid to hang the system
 	if (!tSpecified && nbCPUThread > 1 && gpuEnable)
@@ -609,13 +740,6 @@ int main(int argc, char* argv[]) {
 	if (nbCPUThread < 0)
 		nbCPUThread = 0;
 
-	// If a starting public key is specified, force the search mode according to the key
-	if (!startPuKey.isZero()) {
-		searchMode = (startPubKeyCompressed) ? SEARCH_COMPRESSED : SEARCH_UNCOMPRESSED;
-	}
-
-	VanitySearch* v = new VanitySearch(prefix, seed, searchMode, gpuEnable, stop, outputFile, sse,
-		maxFound, rekey, caseSensitive, startPuKey, paranoiacSeed, startKey);
 	v->Search(nbCPUThread, gpuId, gridSize);
 
 	return 0;